@@ -0,0 +1,39 @@
+/**
+ * \file Accumulator.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This trait selects the data type in which the quadrature rules sum
+ * up the weighted function values for data type TData. By default it is
+ * TData itself. For 16-bit floating point types, which have only 11
+ * (_Float16) or 8 (bfloat16) significant bits, the sum of many terms
+ * would lose all accuracy, so the points and function values are
+ * computed in TData but summed up in float; the result is rounded to
+ * TData once at the end.
+ *
+ * Further 16-bit types specialize the trait where they are defined
+ * (see BFloat16 in 28-quadrature-half).
+ *
+ */
+
+#ifndef ACCUMULATOR_HPP
+#define ACCUMULATOR_HPP
+
+// Data type of the sums for data type TData
+template<typename TData>
+struct Accumulator{
+  typedef TData type;
+};
+
+// The IEEE half precision type of GCC and Clang, which is defined if
+// the compiler defines the limits of the type
+#ifdef __FLT16_MAX__
+template<>
+struct Accumulator<_Float16>{
+  typedef float type;
+};
+#endif
+
+#endif // ACCUMULATOR_HPP
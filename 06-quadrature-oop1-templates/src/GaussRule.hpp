@@ -20,6 +20,12 @@
 #ifndef GAUSS_RULE_HPP
 #define GAUSS_RULE_HPP
 
+// Include header file for standard exception classes
+#include <stdexcept>
+
+// Include header file for the data type of the sums
+#include "Accumulator.hpp"
+
 using namespace std;
 
 // Templated class with data type TData for all floating point data
@@ -32,13 +38,23 @@ private:
   // Number of quadrature points
   TIndex N;
 
-  // Quadrature points
-  TData *x;
+  // Quadrature points, only the non-negative half: the centre node
+  // first if N is odd, followed by the positive points
+  const TData *x;
 
-  // Quadrature weight
-  TData *w;
+  // Quadrature weights of these points
+  const TData *w;
 
 public:
+  // Number of entries that fill 64 bytes (one cache line and one
+  // AVX-512 register for double) and the number of points rounded up
+  // to a multiple of it
+  static constexpr TIndex lanes = sizeof(TData) < 64 ? TIndex(64/sizeof(TData)) : TIndex(1);
+  static constexpr TIndex padded(TIndex n){ return (n+lanes-1)/lanes*lanes; }
+
+  // Number of non-negative points of the n-point rule
+  static constexpr TIndex half(TIndex n){ return (n+1)/2; }
+
   // Standard constructor
   //
   // Here, we use so-called delegating constructors that were
@@ -72,174 +88,231 @@ public:
   GaussRule(TIndex n){
     N = n;
 
-    // Allocate memory and initialize quadrature points and weights
+    // Select quadrature points and weights. Since the points are
+    // symmetric about the centre node, the tables only hold the
+    // half(n) non-negative points and their weights. They are static
+    // local variables that are 64-byte aligned and padded with zero
+    // points and weights up to a multiple of lanes entries.
     switch(n){
-    case 1:
+    case 1:{
       // n = 1
-      x = new TData[n] {0.0};
-      w = new TData[n] {2.0};
+      alignas(64) static const TData x1[padded(half(1))] = {0.0};
+      alignas(64) static const TData w1[padded(half(1))] = {2.0};
+      x = x1; w = w1;
       break;
-    case 2:
+    }
+    case 2:{
       // n = 2
-      x = new TData[n] {0.5773502691896257645091488,
-                        -0.5773502691896257645091488};
-      w = new TData[n] {1.0000000000000000000000000,
-                        1.0000000000000000000000000};
+      alignas(64) static const TData x2[padded(half(2))] = {0.5773502691896257645091488};
+      alignas(64) static const TData w2[padded(half(2))] = {1.0000000000000000000000000};
+      x = x2; w = w2;
       break;
-    case 3:
+    }
+    case 3:{
       // n = 3
-      x = new TData[n] {0.0000000000000000000000000,
-                        0.7745966692414833770358531,
-                        -0.7745966692414833770358531};
-      w = new TData[n] {0.8888888888888888888888889,
-                        0.5555555555555555555555556,
-                        0.5555555555555555555555556};
+      alignas(64) static const TData x3[padded(half(3))] = {0.0000000000000000000000000,
+                                                            0.7745966692414833770358531};
+      alignas(64) static const TData w3[padded(half(3))] = {0.8888888888888888888888889,
+                                                            0.5555555555555555555555556};
+      x = x3; w = w3;
       break;
-    case 4:
+    }
+    case 4:{
       // n = 4
-      x = new TData[n] {0.3399810435848562648026658,
-                        0.8611363115940525752239465,
-                        -0.3399810435848562648026658,
-                        -0.8611363115940525752239465};
-      w = new TData[n] {0.6521451548625461426269361,
-                        0.3478548451374538573730639,
-                        0.6521451548625461426269361,
-                        0.3478548451374538573730639};
+      alignas(64) static const TData x4[padded(half(4))] = {0.3399810435848562648026658,
+                                                            0.8611363115940525752239465};
+      alignas(64) static const TData w4[padded(half(4))] = {0.6521451548625461426269361,
+                                                            0.3478548451374538573730639};
+      x = x4; w = w4;
       break;
-    case 5:
+    }
+    case 5:{
       // n = 5
-      x = new TData[n] {0.0000000000000000000000000,
-                        0.5384693101056830910363144,
-                        0.9061798459386639927976269,
-                        -0.5384693101056830910363144,
-                        -0.9061798459386639927976269};
-      w = new TData[n] {0.5688888888888888888888889,
-                        0.4786286704993664680412915,
-                        0.2369268850561890875142640,
-                        0.4786286704993664680412915,
-                        0.2369268850561890875142640};
+      alignas(64) static const TData x5[padded(half(5))] = {0.0000000000000000000000000,
+                                                            0.5384693101056830910363144,
+                                                            0.9061798459386639927976269};
+      alignas(64) static const TData w5[padded(half(5))] = {0.5688888888888888888888889,
+                                                            0.4786286704993664680412915,
+                                                            0.2369268850561890875142640};
+      x = x5; w = w5;
       break;
-    case 6:
+    }
+    case 6:{
       // n = 6
-      x = new TData[n] {0.2386191860831969086305017,
-                        0.6612093864662645136613996,
-                        0.9324695142031520278123016,
-                        -0.2386191860831969086305017,
-                        -0.6612093864662645136613996,
-                        -0.9324695142031520278123016};
-      w = new TData[n] {0.4679139345726910473898703,
-                        0.3607615730481386075698335,
-                        0.1713244923791703450402961,
-                        0.4679139345726910473898703,
-                        0.3607615730481386075698335,
-                        0.1713244923791703450402961};
+      alignas(64) static const TData x6[padded(half(6))] = {0.2386191860831969086305017,
+                                                            0.6612093864662645136613996,
+                                                            0.9324695142031520278123016};
+      alignas(64) static const TData w6[padded(half(6))] = {0.4679139345726910473898703,
+                                                            0.3607615730481386075698335,
+                                                            0.1713244923791703450402961};
+      x = x6; w = w6;
       break;
-    case 7:
+    }
+    case 7:{
       // n = 7
-      x = new TData[n] {0.0000000000000000000000000,
-                        0.4058451513773971669066064,
-                        0.7415311855993944398638648,
-                        0.9491079123427585245261897,
-                        -0.4058451513773971669066064,
-                        -0.7415311855993944398638648,
-                        -0.9491079123427585245261897};
-      w = new TData[n] {0.4179591836734693877551020,
-                        0.3818300505051189449503698,
-                        0.2797053914892766679014678,
-                        0.1294849661688696932706114,
-                        0.3818300505051189449503698,
-                        0.2797053914892766679014678,
-                        0.1294849661688696932706114};
+      alignas(64) static const TData x7[padded(half(7))] = {0.0000000000000000000000000,
+                                                            0.4058451513773971669066064,
+                                                            0.7415311855993944398638648,
+                                                            0.9491079123427585245261897};
+      alignas(64) static const TData w7[padded(half(7))] = {0.4179591836734693877551020,
+                                                            0.3818300505051189449503698,
+                                                            0.2797053914892766679014678,
+                                                            0.1294849661688696932706114};
+      x = x7; w = w7;
       break;
-    case 8:
+    }
+    case 8:{
       // n = 8
-      x = new TData[n] {0.1834346424956498049394761,
-                        0.5255324099163289858177390,
-                        0.7966664774136267395915539,
-                        0.9602898564975362316835609,
-                        -0.1834346424956498049394761,
-                        -0.5255324099163289858177390,
-                        -0.7966664774136267395915539,
-                        -0.9602898564975362316835609};
-      w = new TData[n] {0.3626837833783619829651504,
-                        0.3137066458778872873379622,
-                        0.2223810344533744705443560,
-                        0.1012285362903762591525314,
-                        0.3626837833783619829651504,
-                        0.3137066458778872873379622,
-                        0.2223810344533744705443560,
-                        0.1012285362903762591525314};
+      alignas(64) static const TData x8[padded(half(8))] = {0.1834346424956498049394761,
+                                                            0.5255324099163289858177390,
+                                                            0.7966664774136267395915539,
+                                                            0.9602898564975362316835609};
+      alignas(64) static const TData w8[padded(half(8))] = {0.3626837833783619829651504,
+                                                            0.3137066458778872873379622,
+                                                            0.2223810344533744705443560,
+                                                            0.1012285362903762591525314};
+      x = x8; w = w8;
       break;
-    case 9:
+    }
+    case 9:{
       // n = 9
-      x = new TData[n] {0.0000000000000000000000000,
-                        0.3242534234038089290385380,
-                        0.6133714327005903973087020,
-                        0.8360311073266357942994298,
-                        0.9681602395076260898355762,
-                        -0.3242534234038089290385380,
-                        -0.6133714327005903973087020,
-                        -0.8360311073266357942994298,
-                        -0.9681602395076260898355762};
-      w = new TData[n] {0.3302393550012597631645251,
-                        0.3123470770400028400686304,
-                        0.2606106964029354623187429,
-                        0.1806481606948574040584720,
-                        0.0812743883615744119718922,
-                        0.3123470770400028400686304,
-                        0.2606106964029354623187429,
-                        0.1806481606948574040584720,
-                        0.0812743883615744119718922};
+      alignas(64) static const TData x9[padded(half(9))] = {0.0000000000000000000000000,
+                                                            0.3242534234038089290385380,
+                                                            0.6133714327005903973087020,
+                                                            0.8360311073266357942994298,
+                                                            0.9681602395076260898355762};
+      alignas(64) static const TData w9[padded(half(9))] = {0.3302393550012597631645251,
+                                                            0.3123470770400028400686304,
+                                                            0.2606106964029354623187429,
+                                                            0.1806481606948574040584720,
+                                                            0.0812743883615744119718922};
+      x = x9; w = w9;
       break;
-    case 10:
+    }
+    case 10:{
       // n = 10
-      x = new TData[n] {0.1488743389816312108848260,
-                        0.4333953941292471907992659,
-                        0.6794095682990244062343274,
-                        0.8650633666889845107320967,
-                        0.9739065285171717200779640,
-                        -0.1488743389816312108848260,
-                        -0.4333953941292471907992659,
-                        -0.6794095682990244062343274,
-                        -0.8650633666889845107320967,
-                        -0.9739065285171717200779640};
-      w = new TData[n] {0.2955242247147528701738930,
-                        0.2692667193099963550912269,
-                        0.2190863625159820439955349,
-                        0.1494513491505805931457763,
-                        0.0666713443086881375935688,
-                        0.2955242247147528701738930,
-                        0.2692667193099963550912269,
-                        0.2190863625159820439955349,
-                        0.1494513491505805931457763,
-                        0.0666713443086881375935688};
+      alignas(64) static const TData x10[padded(half(10))] = {0.1488743389816312108848260,
+                                                              0.4333953941292471907992659,
+                                                              0.6794095682990244062343274,
+                                                              0.8650633666889845107320967,
+                                                              0.9739065285171717200779640};
+      alignas(64) static const TData w10[padded(half(10))] = {0.2955242247147528701738930,
+                                                              0.2692667193099963550912269,
+                                                              0.2190863625159820439955349,
+                                                              0.1494513491505805931457763,
+                                                              0.0666713443086881375935688};
+      x = x10; w = w10;
       break;
-    default:          
-      cout << "Non-supported number of quadrature points." << endl;
-      exit(1);
+    }
+    default:
+      // Throw an exception rather than terminating the program so
+      // that the caller decides what to do. Note that we cannot write
+      // anything to cout here since TData need not be printable.
+      throw invalid_argument("Non-supported number of quadrature points.");
     }
   }
 
-  // Destructor (and there can only be one !!!)
-  ~GaussRule(){
-    // Delete memory for quadrature points and weights
-    delete[] x;
-    delete[] w;
-  }
+  // Destructor (and there can only be one !!!). There is nothing to
+  // do since the tables are static.
+  ~GaussRule(){}
+
+  // Access to the number of points and all points and weights on
+  // [-1,1]. The arrays hold padded_size() entries, the last of which
+  // are zero: first the non-negative points, then the negative ones.
+  // These full tables are kept for users that need every point in one
+  // flat array: the padded SIMD kernels of 14-quadrature-aligned and
+  // 15-quadrature-dispatch and CompositeRule of 13-quadrature-arena,
+  // which also works with rules that have no half tables. They are only
+  // expanded from the half tables when first used, so programs that
+  // only call eval or the half tables do not store them.
+  TIndex size() const { return N; }
+  TIndex padded_size() const { return padded(N); }
+  const TData* points() const { return full_tables()[N-1].x; }
+  const TData* weights() const { return full_tables()[N-1].w; }
+
+  // Access to the half tables, padded to padded(half_size()) entries
+  TIndex half_size() const { return half(N); }
+  const TData* half_points() const { return x; }
+  const TData* half_weights() const { return w; }
 
   // Method that evaluates the integral of a given callback function
   // over the interval [a,b]. This is the simplest way to pass a
   // callback function.
   TData eval(TData f(TData), TData a, TData b){
-    // Initialize local variable
-    TData Int = 0.0;
-
-    // int_a^b f(x) dx = (b-a)/2 * sum_{k=0}^n w[k]*f((b-a)/2 * x[k] + (a+b)/2 ) 
-    for (TIndex k=0; k<N; k++)
-      Int += w[k]*f((b-a)/2.0 * x[k] + (a+b)/2.0);
-    Int *= (b-a)/2.0;
-    return Int;
-  }  
+    return eval<TData(*)(TData)>(f, a, b);
+  }
+
+  // Method that evaluates the integral of an arbitrary callable
+  // object, e.g., a lambda expression with captures or a function
+  // object, over the interval [a,b]. All constants are converted to
+  // TData explicitly so that no double arithmetic sneaks in. This
+  // makes it possible to use GaussRule with user-defined number types
+  // like dual numbers which only need to provide +, * and / and a
+  // constructor from a floating point number. The weighted values are
+  // summed up in the data type of Accumulator, e.g., float for 16-bit
+  // floating point types.
+  template<typename TFunc>
+  TData eval(TFunc f, TData a, TData b){
+    typedef typename Accumulator<TData>::type TAcc;
+
+    // Half length and centre of the interval [a,b]
+    const TData h = (b-a)/TData(2);
+    const TData c = (a+b)/TData(2);
+
+    // Initialize local variable with the contribution of the centre
+    // node, which needs no multiplication by x[0] = 0
+    TAcc Int = TAcc(0);
+    TIndex k = 0;
+    if (N % 2 == 1){
+      Int = TAcc(w[0])*TAcc(f(c));
+      k = 1;
+    }
+
+    // int_a^b f(x) dx = (b-a)/2 * sum_{k=0}^n w[k]*f((b-a)/2 * x[k] + (a+b)/2 )
+    //
+    // The points +x[k] and -x[k] share the weight w[k], so that each
+    // step evaluates f twice independently and multiplies once
+    for (; k<half(N); k++){
+      const TData d = h * x[k];
+      Int += TAcc(w[k])*(TAcc(f(c + d)) + TAcc(f(c - d)));
+    }
+    Int *= TAcc(h);
+    return TData(Int);
+  }
+
+private:
+  // Full tables of the n-point rules for n=1,...,10. The struct is
+  // 64-byte aligned, so that every row is. Initialization of
+  // function-local static variables is thread-safe in C++11.
+  struct FullTable{
+    alignas(64) TData x[padded(10)];
+    alignas(64) TData w[padded(10)];
+  };
+
+  static const FullTable* full_tables(){
+    static const FullTable* tables = [](){
+      static FullTable t[10];
+      for (TIndex n=1; n<=10; n++){
+        const GaussRule rule(n);
+        FullTable& T = t[n-1];
+        for (TIndex k=0; k<padded(10); k++){
+          T.x[k] = TData(0);
+          T.w[k] = TData(0);
+        }
+        TIndex i = 0;
+        for (TIndex k=0; k<half(n); k++, i++){
+          T.x[i] = rule.x[k];
+          T.w[i] = rule.w[k];
+        }
+        for (TIndex k=n%2; k<half(n); k++, i++){
+          T.x[i] = -rule.x[k];
+          T.w[i] = rule.w[k];
+        }
+      }
+      return static_cast<const FullTable*>(t);
+    }();
+    return tables;
+  }
   
 }; // Do not forget ";" after the closing brace of a class definition !!!
 
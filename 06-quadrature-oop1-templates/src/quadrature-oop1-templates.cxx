@@ -80,49 +80,57 @@ int main (int argc,  char** argv){
     exit(-1);
   }
 
-  // Instantiate 3-pt Gauss rule by default constructor
-  GaussRule<DataType,IndexType> GR3; // no (), really not !!!
-
-  // Instantiate n-pt Gauss rule by alternative constructor
-  GaussRule<DataType,IndexType> GRn(n);
-
-  // Output
-  cout << "Numerical integration of cos(x) over [" << a << "," << b << "]:" << endl;
-
-  // Make use of traditional way to pass callback functions
-  cout << "3-pt Gauss quadrature rule: " << GR3.eval(myfunc, a, b) << endl;
-  cout << n << "-pt Gauss quadrature rule: " << GRn.eval(myfunc, a, b) << endl;
-
-  // Define C++11 Lambda expression of the general form
-  // auto name = [] () {};
-  //
-  // The auto specifier (new in C++11) tells the compiler that the
-  // type of the variable that is being declared will be automatically
-  // deduced from its initializer. In the following example it is
-  // deduced from the result type of cos(x) when x is of type
-  // double. Hence, auto will be double.
-  //
-  // The so-called capture specification "[]" tells the compiler the
-  // we are creating a lambda function.
-  //
-  // The list of arguments that is passed to the function is given
-  // within "()"
-  //
-  // The function body, i.e. the expression that should be calculated
-  // is given within "{}"
-  //
-  // Okay, let's go
-  auto myfunc_lambda = [](DataType x){return cos(x);};
-  
-  // Pass callback function using C++11 Lambda expressions
-  cout << "3-pt Gauss quadrature rule: " << GR3.eval(myfunc_lambda, a, b) << endl;
-  cout << n << "-pt Gauss quadrature rule: " << GRn.eval(myfunc_lambda, a, b) << endl;
-
-  // We can even inline the lambda expression. That is, what lambda
-  // expressions are actually meant for, efficient coding.
-  cout << "3-pt Gauss quadrature rule: " << GR3.eval([](DataType x){return cos(x);}, a, b) << endl;
-  cout << n << "-pt Gauss quadrature rule: " << GRn.eval([](DataType x){return cos(x);}, a, b) << endl;
-  
+  // The constructor of GaussRule throws an exception for an unsupported
+  // number of points, which we catch to print an error message
+  try{
+    // Instantiate 3-pt Gauss rule by default constructor
+    GaussRule<DataType,IndexType> GR3; // no (), really not !!!
+
+    // Instantiate n-pt Gauss rule by alternative constructor
+    GaussRule<DataType,IndexType> GRn(n);
+
+    // Output
+    cout << "Numerical integration of cos(x) over [" << a << "," << b << "]:" << endl;
+
+    // Make use of traditional way to pass callback functions
+    cout << "3-pt Gauss quadrature rule: " << GR3.eval(myfunc, a, b) << endl;
+    cout << n << "-pt Gauss quadrature rule: " << GRn.eval(myfunc, a, b) << endl;
+
+    // Define C++11 Lambda expression of the general form
+    // auto name = [] () {};
+    //
+    // The auto specifier (new in C++11) tells the compiler that the
+    // type of the variable that is being declared will be automatically
+    // deduced from its initializer. In the following example it is
+    // deduced from the result type of cos(x) when x is of type
+    // double. Hence, auto will be double.
+    //
+    // The so-called capture specification "[]" tells the compiler the
+    // we are creating a lambda function.
+    //
+    // The list of arguments that is passed to the function is given
+    // within "()"
+    //
+    // The function body, i.e. the expression that should be calculated
+    // is given within "{}"
+    //
+    // Okay, let's go
+    auto myfunc_lambda = [](DataType x){return cos(x);};
+
+    // Pass callback function using C++11 Lambda expressions
+    cout << "3-pt Gauss quadrature rule: " << GR3.eval(myfunc_lambda, a, b) << endl;
+    cout << n << "-pt Gauss quadrature rule: " << GRn.eval(myfunc_lambda, a, b) << endl;
+
+    // We can even inline the lambda expression. That is, what lambda
+    // expressions are actually meant for, efficient coding.
+    cout << "3-pt Gauss quadrature rule: " << GR3.eval([](DataType x){return cos(x);}, a, b) << endl;
+    cout << n << "-pt Gauss quadrature rule: " << GRn.eval([](DataType x){return cos(x);}, a, b) << endl;
+  }
+  catch (const invalid_argument& e){
+    cerr << "Error: " << e.what() << endl;
+    exit(-1);
+  }
+
   // End program
   return 0;
 }
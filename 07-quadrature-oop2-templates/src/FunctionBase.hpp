@@ -21,6 +21,13 @@
 #ifndef FUNCTION_BASE_HPP
 #define FUNCTION_BASE_HPP
 
+// Include header file for standard exception classes
+#include <stdexcept>
+
+// Include header file for the data type of the sums (see
+// 06-quadrature-oop1-templates)
+#include "Accumulator.hpp"
+
 using namespace std;
 
 // Templated class with data type TData for all floating point data.
@@ -31,6 +38,15 @@ class FunctionBase{
 private:
   
 public:
+  // Number of entries that fill 64 bytes and the number of points
+  // rounded up to a multiple of it, see GaussRule in
+  // 06-quadrature-oop1-templates
+  static constexpr int lanes = sizeof(TData) < 64 ? int(64/sizeof(TData)) : 1;
+  static constexpr int padded(int n){ return (n+lanes-1)/lanes*lanes; }
+
+  // Number of non-negative points of the n-point rule
+  static constexpr int half(int n){ return (n+1)/2; }
+
   // The ()-operator (=access operator) is implemented as
   // virtual. That means, that we need to implement this operator in
   // any class that is derived from class FunctionBase
@@ -45,162 +61,156 @@ public:
   template<typename TIndex=int>
   TData integrate(TData a, TData b, TIndex n=3){
     // Define local variables
-    TData *x, *w;
+    const TData *x, *w;
     
-    // Allocate memory and initialize quadrature points and weights
+    // Select quadrature points and weights. The tables are static
+    // local variables, so they are initialized once on first use and
+    // no memory is allocated (or leaked) per call. As in GaussRule,
+    // they only hold the half(n) non-negative points (the centre node
+    // first if n is odd) and are 64-byte aligned and padded with zero
+    // points and weights.
     switch(n){
-    case 1:
+    case 1:{
       // n = 1
-      x = new TData[n] {0.0};
-      w = new TData[n] {2.0};
+      alignas(64) static const TData x1[padded(half(1))] = {0.0};
+      alignas(64) static const TData w1[padded(half(1))] = {2.0};
+      x = x1; w = w1;
       break;
-    case 2:
+    }
+    case 2:{
       // n = 2
-      x = new TData[n] {0.5773502691896257645091488,
-                        -0.5773502691896257645091488};
-      w = new TData[n] {1.0000000000000000000000000,
-                        1.0000000000000000000000000};
+      alignas(64) static const TData x2[padded(half(2))] = {0.5773502691896257645091488};
+      alignas(64) static const TData w2[padded(half(2))] = {1.0000000000000000000000000};
+      x = x2; w = w2;
       break;
-    case 3:
+    }
+    case 3:{
       // n = 3
-      x = new TData[n] {0.0000000000000000000000000,
-                        0.7745966692414833770358531,
-                        -0.7745966692414833770358531};
-      w = new TData[n] {0.8888888888888888888888889,
-                        0.5555555555555555555555556,
-                        0.5555555555555555555555556};
+      alignas(64) static const TData x3[padded(half(3))] = {0.0000000000000000000000000,
+                                                            0.7745966692414833770358531};
+      alignas(64) static const TData w3[padded(half(3))] = {0.8888888888888888888888889,
+                                                            0.5555555555555555555555556};
+      x = x3; w = w3;
       break;
-    case 4:
+    }
+    case 4:{
       // n = 4
-      x = new TData[n] {0.3399810435848562648026658,
-                        0.8611363115940525752239465,
-                        -0.3399810435848562648026658,
-                        -0.8611363115940525752239465};
-      w = new TData[n] {0.6521451548625461426269361,
-                        0.3478548451374538573730639,
-                        0.6521451548625461426269361,
-                        0.3478548451374538573730639};
+      alignas(64) static const TData x4[padded(half(4))] = {0.3399810435848562648026658,
+                                                            0.8611363115940525752239465};
+      alignas(64) static const TData w4[padded(half(4))] = {0.6521451548625461426269361,
+                                                            0.3478548451374538573730639};
+      x = x4; w = w4;
       break;
-    case 5:
+    }
+    case 5:{
       // n = 5
-      x = new TData[n] {0.0000000000000000000000000,
-                        0.5384693101056830910363144,
-                        0.9061798459386639927976269,
-                        -0.5384693101056830910363144,
-                        -0.9061798459386639927976269};
-      w = new TData[n] {0.5688888888888888888888889,
-                        0.4786286704993664680412915,
-                        0.2369268850561890875142640,
-                        0.4786286704993664680412915,
-                        0.2369268850561890875142640};
+      alignas(64) static const TData x5[padded(half(5))] = {0.0000000000000000000000000,
+                                                            0.5384693101056830910363144,
+                                                            0.9061798459386639927976269};
+      alignas(64) static const TData w5[padded(half(5))] = {0.5688888888888888888888889,
+                                                            0.4786286704993664680412915,
+                                                            0.2369268850561890875142640};
+      x = x5; w = w5;
       break;
-    case 6:
+    }
+    case 6:{
       // n = 6
-      x = new TData[n] {0.2386191860831969086305017,
-                        0.6612093864662645136613996,
-                        0.9324695142031520278123016,
-                        -0.2386191860831969086305017,
-                        -0.6612093864662645136613996,
-                        -0.9324695142031520278123016};
-      w = new TData[n] {0.4679139345726910473898703,
-                        0.3607615730481386075698335,
-                        0.1713244923791703450402961,
-                        0.4679139345726910473898703,
-                        0.3607615730481386075698335,
-                        0.1713244923791703450402961};
+      alignas(64) static const TData x6[padded(half(6))] = {0.2386191860831969086305017,
+                                                            0.6612093864662645136613996,
+                                                            0.9324695142031520278123016};
+      alignas(64) static const TData w6[padded(half(6))] = {0.4679139345726910473898703,
+                                                            0.3607615730481386075698335,
+                                                            0.1713244923791703450402961};
+      x = x6; w = w6;
       break;
-    case 7:
+    }
+    case 7:{
       // n = 7
-      x = new TData[n] {0.0000000000000000000000000,
-                        0.4058451513773971669066064,
-                        0.7415311855993944398638648,
-                        0.9491079123427585245261897,
-                        -0.4058451513773971669066064,
-                        -0.7415311855993944398638648,
-                        -0.9491079123427585245261897};
-      w = new TData[n] {0.4179591836734693877551020,
-                        0.3818300505051189449503698,
-                        0.2797053914892766679014678,
-                        0.1294849661688696932706114,
-                        0.3818300505051189449503698,
-                        0.2797053914892766679014678,
-                        0.1294849661688696932706114};
+      alignas(64) static const TData x7[padded(half(7))] = {0.0000000000000000000000000,
+                                                            0.4058451513773971669066064,
+                                                            0.7415311855993944398638648,
+                                                            0.9491079123427585245261897};
+      alignas(64) static const TData w7[padded(half(7))] = {0.4179591836734693877551020,
+                                                            0.3818300505051189449503698,
+                                                            0.2797053914892766679014678,
+                                                            0.1294849661688696932706114};
+      x = x7; w = w7;
       break;
-    case 8:
+    }
+    case 8:{
       // n = 8
-      x = new TData[n] {0.1834346424956498049394761,
-                        0.5255324099163289858177390,
-                        0.7966664774136267395915539,
-                        0.9602898564975362316835609,
-                        -0.1834346424956498049394761,
-                        -0.5255324099163289858177390,
-                        -0.7966664774136267395915539,
-                        -0.9602898564975362316835609};
-      w = new TData[n] {0.3626837833783619829651504,
-                        0.3137066458778872873379622,
-                        0.2223810344533744705443560,
-                        0.1012285362903762591525314,
-                        0.3626837833783619829651504,
-                        0.3137066458778872873379622,
-                        0.2223810344533744705443560,
-                        0.1012285362903762591525314};
+      alignas(64) static const TData x8[padded(half(8))] = {0.1834346424956498049394761,
+                                                            0.5255324099163289858177390,
+                                                            0.7966664774136267395915539,
+                                                            0.9602898564975362316835609};
+      alignas(64) static const TData w8[padded(half(8))] = {0.3626837833783619829651504,
+                                                            0.3137066458778872873379622,
+                                                            0.2223810344533744705443560,
+                                                            0.1012285362903762591525314};
+      x = x8; w = w8;
       break;
-    case 9:
+    }
+    case 9:{
       // n = 9
-      x = new TData[n] {0.0000000000000000000000000,
-                        0.3242534234038089290385380,
-                        0.6133714327005903973087020,
-                        0.8360311073266357942994298,
-                        0.9681602395076260898355762,
-                        -0.3242534234038089290385380,
-                        -0.6133714327005903973087020,
-                        -0.8360311073266357942994298,
-                        -0.9681602395076260898355762};
-      w = new TData[n] {0.3302393550012597631645251,
-                        0.3123470770400028400686304,
-                        0.2606106964029354623187429,
-                        0.1806481606948574040584720,
-                        0.0812743883615744119718922,
-                        0.3123470770400028400686304,
-                        0.2606106964029354623187429,
-                        0.1806481606948574040584720,
-                        0.0812743883615744119718922};
+      alignas(64) static const TData x9[padded(half(9))] = {0.0000000000000000000000000,
+                                                            0.3242534234038089290385380,
+                                                            0.6133714327005903973087020,
+                                                            0.8360311073266357942994298,
+                                                            0.9681602395076260898355762};
+      alignas(64) static const TData w9[padded(half(9))] = {0.3302393550012597631645251,
+                                                            0.3123470770400028400686304,
+                                                            0.2606106964029354623187429,
+                                                            0.1806481606948574040584720,
+                                                            0.0812743883615744119718922};
+      x = x9; w = w9;
       break;
-    case 10:
+    }
+    case 10:{
       // n = 10
-      x = new TData[n] {0.1488743389816312108848260,
-                        0.4333953941292471907992659,
-                        0.6794095682990244062343274,
-                        0.8650633666889845107320967,
-                        0.9739065285171717200779640,
-                        -0.1488743389816312108848260,
-                        -0.4333953941292471907992659,
-                        -0.6794095682990244062343274,
-                        -0.8650633666889845107320967,
-                        -0.9739065285171717200779640};
-      w = new TData[n] {0.2955242247147528701738930,
-                        0.2692667193099963550912269,
-                        0.2190863625159820439955349,
-                        0.1494513491505805931457763,
-                        0.0666713443086881375935688,
-                        0.2955242247147528701738930,
-                        0.2692667193099963550912269,
-                        0.2190863625159820439955349,
-                        0.1494513491505805931457763,
-                        0.0666713443086881375935688};
+      alignas(64) static const TData x10[padded(half(10))] = {0.1488743389816312108848260,
+                                                              0.4333953941292471907992659,
+                                                              0.6794095682990244062343274,
+                                                              0.8650633666889845107320967,
+                                                              0.9739065285171717200779640};
+      alignas(64) static const TData w10[padded(half(10))] = {0.2955242247147528701738930,
+                                                              0.2692667193099963550912269,
+                                                              0.2190863625159820439955349,
+                                                              0.1494513491505805931457763,
+                                                              0.0666713443086881375935688};
+      x = x10; w = w10;
       break;
-    default:          
-      cout << "Non-supported number of quadrature points." << endl;
-      exit(1);
+    }
+    default:
+      // Throw an exception rather than terminating the program so
+      // that the caller decides what to do
+      throw invalid_argument("Non-supported number of quadrature points.");
     }
 
     // Finally, perform numerical integration:
     // int_a^b f(x) dx = (b-a)/2 * sum_{k=0}^n w[k]*f((b-a)/2 * x[k] + (a+b)/2 )
-    TData Int=0.0;
-    for (TIndex k=0; k<n; k++)
-      Int += w[k]*(*this)((b-a)/2.0 * x[k] + (a+b)/2.0);
-    Int *= (b-a)/2.0;
-    return Int;
+    //
+    // All constants are converted to TData explicitly so that the
+    // class can also be used with user-defined number types like dual
+    // numbers (see 08-quadrature-autodiff)
+    //
+    // The points +x[k] and -x[k] share the weight w[k]; the centre
+    // node of an odd rule is evaluated separately. As in GaussRule, the
+    // sum is computed in the data type of Accumulator.
+    typedef typename Accumulator<TData>::type TAcc;
+    const TData h = (b-a)/TData(2);
+    const TData c = (a+b)/TData(2);
+    TAcc Int = TAcc(0);
+    TIndex k = 0;
+    if (n % 2 == 1){
+      Int = TAcc(w[0])*TAcc((*this)(c));
+      k = 1;
+    }
+    for (; k<half(n); k++){
+      const TData d = h * x[k];
+      Int += TAcc(w[k])*(TAcc((*this)(c + d)) + TAcc((*this)(c - d)));
+    }
+    Int *= TAcc(h);
+    return TData(Int);
   }
 }; // Do not forget ";" after the closing brace of a class definition !!!
 
@@ -86,12 +86,21 @@ int main (int argc,  char** argv){
     exit(-1);
   }
 
-  auto f1 = Function1<DataType>();
+  // FunctionBase::integrate throws an exception for an unsupported
+  // number of points, which we catch to print an error message
+  try{
+    auto f1 = Function1<DataType>();
+    DataType Int = f1.integrate(a,b,n);
+
+    // Output
+    cout << "Numerical integration of cos(x) over [" << a << "," << b << "]:" << endl;
+    cout << n << "-pt Gauss quadrature rule: " << Int << endl;
+  }
+  catch (const invalid_argument& e){
+    cerr << "Error: " << e.what() << endl;
+    exit(-1);
+  }
 
-  // Output
-  cout << "Numerical integration of cos(x) over [" << a << "," << b << "]:" << endl;
-  cout << n << "-pt Gauss quadrature rule: " << f1.integrate(a,b,n) << endl;
-  
   // End program
   return 0;
 }
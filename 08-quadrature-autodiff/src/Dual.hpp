@@ -0,0 +1,201 @@
+/**
+ * \file Dual.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements forward-mode automatic differentiation by
+ * means of (vector-)dual numbers. A dual number carries a value v and
+ * the gradient g = (dv/dp_1, ..., dv/dp_P) with respect to P
+ * parameters p_1, ..., p_P. All arithmetic operations and elementary
+ * functions propagate the gradient by the chain rule.
+ *
+ * Since Dual<T,P> provides all operations that GaussRule<TData> and
+ * FunctionBase<TData> need, the integral of a parametrized function
+ * and its gradient with respect to all parameters are computed in a
+ * single pass over the quadrature points.
+ *
+ */
+
+#ifndef DUAL_HPP
+#define DUAL_HPP
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header file for mathematical functions
+#include <cmath>
+
+using namespace std;
+
+// Templated class with data type T for the value and all gradient
+// entries and the number P of parameters. P=1 yields the classical
+// dual number a + b*eps with eps^2 = 0.
+template<typename T=double, int P=1>
+class Dual{
+
+public:
+  // Value
+  T val;
+
+  // Gradient with respect to the parameters p_1, ..., p_P. The fixed
+  // size makes it possible for the compiler to vectorize all loops
+  // over the gradient entries.
+  T grad[P];
+
+  // Standard constructor: zero value and zero gradient
+  Dual() : Dual(T(0)) {}
+
+  // Constructor from a constant. This constructor is deliberately not
+  // explicit so that quadrature points, weights and literals can be
+  // converted to Dual<T,P> implicitly.
+  Dual(T v) : val(v){
+    for (int i=0; i<P; i++)
+      grad[i] = T(0);
+  }
+
+  // Constructor for the i-th independent parameter with value v, that
+  // is, the gradient is the i-th unit vector
+  Dual(T v, int i) : Dual(v){
+    grad[i] = T(1);
+  }
+
+  // Unary operators
+  Dual operator+() const { return *this; }
+  Dual operator-() const {
+    Dual r;
+    r.val = -val;
+    for (int i=0; i<P; i++)
+      r.grad[i] = -grad[i];
+    return r;
+  }
+
+  // Compound assignment operators
+  Dual& operator+=(const Dual& o){
+    val += o.val;
+    for (int i=0; i<P; i++)
+      grad[i] += o.grad[i];
+    return *this;
+  }
+
+  Dual& operator-=(const Dual& o){
+    val -= o.val;
+    for (int i=0; i<P; i++)
+      grad[i] -= o.grad[i];
+    return *this;
+  }
+
+  // (uv)' = u'v + uv'
+  Dual& operator*=(const Dual& o){
+    for (int i=0; i<P; i++)
+      grad[i] = grad[i]*o.val + val*o.grad[i];
+    val *= o.val;
+    return *this;
+  }
+
+  // (u/v)' = (u' - (u/v)v')/v
+  Dual& operator/=(const Dual& o){
+    const T inv = T(1)/o.val;
+    val *= inv;
+    for (int i=0; i<P; i++)
+      grad[i] = (grad[i] - val*o.grad[i])*inv;
+    return *this;
+  }
+
+  // Multiplication and division by a constant need not touch the
+  // product rule
+  Dual& operator*=(T s){
+    val *= s;
+    for (int i=0; i<P; i++)
+      grad[i] *= s;
+    return *this;
+  }
+
+  Dual& operator/=(T s){
+    return (*this) *= T(1)/s;
+  }
+
+  // Apply the chain rule for an elementary function with value fv and
+  // derivative df at val
+  Dual chain(T fv, T df) const {
+    Dual r;
+    r.val = fv;
+    for (int i=0; i<P; i++)
+      r.grad[i] = df*grad[i];
+    return r;
+  }
+};
+
+// Binary arithmetic operators are implemented in terms of the
+// compound assignment operators. The variants with a constant T on
+// either side avoid promoting the constant to a full dual number.
+template<typename T, int P>
+Dual<T,P> operator+(Dual<T,P> l, const Dual<T,P>& r) { return l += r; }
+template<typename T, int P>
+Dual<T,P> operator+(Dual<T,P> l, T r) { l.val += r; return l; }
+template<typename T, int P>
+Dual<T,P> operator+(T l, Dual<T,P> r) { r.val += l; return r; }
+
+template<typename T, int P>
+Dual<T,P> operator-(Dual<T,P> l, const Dual<T,P>& r) { return l -= r; }
+template<typename T, int P>
+Dual<T,P> operator-(Dual<T,P> l, T r) { l.val -= r; return l; }
+template<typename T, int P>
+Dual<T,P> operator-(T l, const Dual<T,P>& r) { Dual<T,P> d = -r; d.val += l; return d; }
+
+template<typename T, int P>
+Dual<T,P> operator*(Dual<T,P> l, const Dual<T,P>& r) { return l *= r; }
+template<typename T, int P>
+Dual<T,P> operator*(Dual<T,P> l, T r) { return l *= r; }
+template<typename T, int P>
+Dual<T,P> operator*(T l, Dual<T,P> r) { return r *= l; }
+
+template<typename T, int P>
+Dual<T,P> operator/(Dual<T,P> l, const Dual<T,P>& r) { return l /= r; }
+template<typename T, int P>
+Dual<T,P> operator/(Dual<T,P> l, T r) { return l /= r; }
+template<typename T, int P>
+Dual<T,P> operator/(T l, const Dual<T,P>& r) { return Dual<T,P>(l) /= r; }
+
+// Comparison operators only compare the values
+template<typename T, int P>
+bool operator<(const Dual<T,P>& l, const Dual<T,P>& r) { return l.val < r.val; }
+template<typename T, int P>
+bool operator>(const Dual<T,P>& l, const Dual<T,P>& r) { return l.val > r.val; }
+
+// Elementary functions. They are found by argument-dependent lookup,
+// so that an integrand written as cos(x) works for T and Dual<T,P>.
+template<typename T, int P>
+Dual<T,P> sin(const Dual<T,P>& x) { return x.chain(std::sin(x.val), std::cos(x.val)); }
+
+template<typename T, int P>
+Dual<T,P> cos(const Dual<T,P>& x) { return x.chain(std::cos(x.val), -std::sin(x.val)); }
+
+template<typename T, int P>
+Dual<T,P> exp(const Dual<T,P>& x) { T e = std::exp(x.val); return x.chain(e, e); }
+
+template<typename T, int P>
+Dual<T,P> log(const Dual<T,P>& x) { return x.chain(std::log(x.val), T(1)/x.val); }
+
+template<typename T, int P>
+Dual<T,P> sqrt(const Dual<T,P>& x) { T s = std::sqrt(x.val); return x.chain(s, T(1)/(T(2)*s)); }
+
+template<typename T, int P>
+Dual<T,P> abs(const Dual<T,P>& x) { return x.val < T(0) ? -x : x; }
+
+template<typename T, int P>
+Dual<T,P> pow(const Dual<T,P>& x, T e) {
+  return x.chain(std::pow(x.val, e), e*std::pow(x.val, e-T(1)));
+}
+
+// Output operator: value followed by the gradient
+template<typename T, int P>
+ostream& operator<<(ostream& os, const Dual<T,P>& x){
+  os << x.val << " [";
+  for (int i=0; i<P; i++)
+    os << (i ? ", " : "") << x.grad[i];
+  return os << "]";
+}
+
+#endif // DUAL_HPP
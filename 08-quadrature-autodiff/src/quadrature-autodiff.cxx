@@ -0,0 +1,136 @@
+/**
+ * \file quadrature-autodiff.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we use forward-mode automatic differentiation to
+ * compute the integral
+ *
+ * \verbatim
+ * I(omega,phi) = int_a^b cos(omega*x + phi) dx
+ * \endverbatim
+ *
+ * together with its gradient (dI/domega, dI/dphi) in a single pass
+ * over the quadrature points. The templated classes GaussRule and
+ * FunctionBase are simply instantiated with TData = Dual<double,2>.
+ * The result is compared with central finite differences, which need
+ * 2*P=4 additional integrations.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header file for standard utility library
+#include <cstdlib>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header file for dual numbers
+#include "Dual.hpp"
+
+// Include header files for Gauss quadrature rules and functions
+#include "GaussRule.hpp"
+#include "FunctionBase.hpp"
+
+using namespace std;
+
+// Define data types: two parameters (omega, phi)
+typedef double             DataType;
+typedef Dual<DataType,2>   DualType;
+typedef int                IndexType;
+
+// Create templated class Function1 that inherits from class
+// FunctionBase. The parameters omega and phi are stored as members of
+// type TData so that their gradients are propagated automatically.
+template<typename TData=double>
+class Function1 : public FunctionBase<TData>{
+public:
+  Function1(TData omega, TData phi) : omega(omega), phi(phi) {}
+
+  TData operator()(TData x){
+    return cos(omega*x + phi);
+  }
+
+private:
+  TData omega, phi;
+};
+
+// Exact integral int_a^b cos(omega*x + phi) dx
+DataType exact(DataType omega, DataType phi, DataType a, DataType b){
+  return (sin(omega*b+phi) - sin(omega*a+phi))/omega;
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of quadrature points and parameters from command line
+  // arguments
+  DataType a=0.0, b=2.0*M_PI, omega=1.5, phi=0.3;
+  IndexType n = 10;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    n = atoi(argv[1]);
+    break;
+  case 4:
+    n     = atoi(argv[1]);
+    omega = atof(argv[2]);
+    phi   = atof(argv[3]);
+    break;
+  default:
+    cout << "Usage: quadrature-autodiff" << endl;
+    cout << "       quadrature-autodiff n" << endl;
+    cout << "       quadrature-autodiff n omega phi" << endl;
+    exit(-1);
+  }
+
+  // Independent parameters: omega is parameter 0 and phi is
+  // parameter 1. The integration bounds are constants.
+  DualType p_omega(omega, 0), p_phi(phi, 1);
+
+  // (a) GaussRule with a lambda expression that captures the parameters
+  GaussRule<DualType,IndexType> GRn(n);
+  DualType Int1 = GRn.eval([&](DualType x){ return cos(p_omega*x + p_phi); },
+                           DualType(a), DualType(b));
+
+  // (b) FunctionBase with a function object that stores the parameters
+  Function1<DualType> f1(p_omega, p_phi);
+  DualType Int2 = f1.integrate(DualType(a), DualType(b), n);
+
+  // (c) Central finite differences need 2*P extra integrations
+  GaussRule<DataType,IndexType> GRd(n);
+  const DataType eps = 1e-6;
+  auto I = [&](DataType om, DataType ph){
+    return GRd.eval([=](DataType x){ return cos(om*x + ph); }, a, b);
+  };
+  DataType dI_domega = (I(omega+eps,phi) - I(omega-eps,phi))/(2.0*eps);
+  DataType dI_dphi   = (I(omega,phi+eps) - I(omega,phi-eps))/(2.0*eps);
+
+  // Exact values
+  DataType Iex = exact(omega, phi, a, b);
+  DataType dIex_domega = (b*cos(omega*b+phi) - a*cos(omega*a+phi))/omega - Iex/omega;
+  DataType dIex_dphi   = (cos(omega*b+phi) - cos(omega*a+phi))/omega;
+
+  // Output
+  cout.precision(12);
+  cout << "Numerical integration of cos(omega*x+phi) over [" << a << "," << b << "]"
+       << " with omega=" << omega << ", phi=" << phi << ":" << endl;
+  cout << "GaussRule<Dual>    I [dI/domega, dI/dphi]: " << Int1 << endl;
+  cout << "FunctionBase<Dual> I [dI/domega, dI/dphi]: " << Int2 << endl;
+  cout << "Finite differences   [dI/domega, dI/dphi]:   ["
+       << dI_domega << ", " << dI_dphi << "]" << endl;
+  cout << "Exact              I [dI/domega, dI/dphi]: " << Iex << " ["
+       << dIex_domega << ", " << dIex_dphi << "]" << endl;
+
+  // End program
+  return 0;
+}
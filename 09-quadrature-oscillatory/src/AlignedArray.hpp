@@ -0,0 +1,101 @@
+/**
+ * \file AlignedArray.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements a fixed-size array whose memory is aligned to
+ * Align bytes (by default 64, i.e. one cache line and one AVX-512
+ * register) and whose length is rounded up to a multiple of
+ * Align/sizeof(T) entries. The padding is value-initialized, i.e. zero
+ * for floating point types.
+ *
+ * For quadrature tables this means that a vectorized kernel can load
+ * full registers with aligned loads and process the padding like any
+ * other point: a zero weight does not change the sum, so there is no
+ * scalar remainder loop.
+ *
+ */
+
+#ifndef ALIGNED_ARRAY_HPP
+#define ALIGNED_ARRAY_HPP
+
+// Include header files for size types and pointer arithmetic
+#include <cstddef>
+#include <cstdint>
+
+// Include header files for placement new and type traits
+#include <new>
+#include <type_traits>
+
+using namespace std;
+
+template<typename T, size_t Align=64>
+class AlignedArray{
+
+  static_assert((Align & (Align-1)) == 0, "Alignment must be a power of two.");
+  static_assert(is_trivially_destructible<T>::value,
+                "AlignedArray does not call destructors.");
+
+public:
+  // Number of entries per Align bytes and the length n rounded up to a
+  // multiple of it
+  static constexpr size_t lanes = sizeof(T) < Align ? Align/sizeof(T) : 1;
+  static constexpr size_t padded(size_t n){ return (n+lanes-1)/lanes*lanes; }
+
+  // Constructor: allocate and zero n entries plus padding
+  explicit AlignedArray(size_t n=0) : n(n), np(padded(n)), raw(nullptr), ptr(nullptr){
+    if (np == 0)
+      return;
+    // Over-allocate by Align bytes and round the address up, which
+    // works with C++11 (aligned operator new requires C++17)
+    raw = static_cast<char*>(::operator new(np*sizeof(T) + Align));
+    uintptr_t p = (reinterpret_cast<uintptr_t>(raw) + Align-1) & ~uintptr_t(Align-1);
+    ptr = reinterpret_cast<T*>(p);
+    for (size_t i=0; i<np; i++)
+      new (ptr+i) T();
+  }
+
+  // Arrays can be moved but not copied
+  AlignedArray(const AlignedArray&) = delete;
+  AlignedArray& operator=(const AlignedArray&) = delete;
+
+  AlignedArray(AlignedArray&& other) noexcept
+    : n(other.n), np(other.np), raw(other.raw), ptr(other.ptr){
+    other.n = other.np = 0;
+    other.raw = nullptr;
+    other.ptr = nullptr;
+  }
+
+  AlignedArray& operator=(AlignedArray&& other) noexcept {
+    if (this != &other){
+      ::operator delete(raw);
+      n = other.n; np = other.np; raw = other.raw; ptr = other.ptr;
+      other.n = other.np = 0;
+      other.raw = nullptr;
+      other.ptr = nullptr;
+    }
+    return *this;
+  }
+
+  // Destructor
+  ~AlignedArray(){ ::operator delete(raw); }
+
+  // Number of entries without and with padding
+  size_t size() const { return n; }
+  size_t padded_size() const { return np; }
+
+  // Access to the data
+  T* data() { return ptr; }
+  const T* data() const { return ptr; }
+  T& operator[](size_t i) { return ptr[i]; }
+  const T& operator[](size_t i) const { return ptr[i]; }
+
+private:
+  size_t n, np;
+  char* raw;
+  T* ptr;
+};
+
+#endif // ALIGNED_ARRAY_HPP
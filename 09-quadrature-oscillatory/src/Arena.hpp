@@ -0,0 +1,252 @@
+/**
+ * \file Arena.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements a bump (or arena) allocator for the scratch
+ * memory of the integration routines, e.g., mapped points, function
+ * values and interval stacks.
+ *
+ * An allocation only advances an offset into a large chunk of memory
+ * and nothing is freed individually. Instead, the state of the arena
+ * is saved by mark() and restored by rewind(), which releases all
+ * memory allocated in between at once. The chunks themselves are kept
+ * for reuse, so that once the arena has grown to the working set of
+ * an application, repeated integration does not touch the heap at
+ * all. Every thread has its own arena, see Arena::local(), so that no
+ * locking is needed.
+ *
+ * The usual pattern is
+ *
+ * \verbatim
+ * {
+ *   ArenaScope scope;                   // mark the thread-local arena
+ *   TData* fv = scope.allocate<TData>(n);
+ *   ...
+ * }                                     // rewind, fv is released
+ * \endverbatim
+ *
+ * For standard containers there is the allocator ArenaAllocator and,
+ * if the compiler supports C++17, the polymorphic memory resource
+ * ArenaResource.
+ *
+ */
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+// Include header files for size types and alignment
+#include <cstddef>
+#include <cstdint>
+
+// Include header files for placement new, type traits and the vector
+// container
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Polymorphic memory resources are only available in C++17
+#if defined(__has_include)
+#if __cplusplus >= 201703L && __has_include(<memory_resource>)
+#include <memory_resource>
+#define ARENA_HAS_PMR 1
+#endif
+#endif
+
+using namespace std;
+
+class Arena{
+
+public:
+  // State of the arena as returned by mark()
+  struct Marker{
+    size_t chunk;
+    size_t offset;
+  };
+
+  // Constructor: chunks are allocated with at least chunksize bytes
+  explicit Arena(size_t chunksize=size_t(1) << 16)
+    : chunksize(chunksize), current(0), offset(0){}
+
+  // The arena owns its chunks, so it must not be copied
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // Destructor
+  ~Arena(){
+    for (auto& c : chunks)
+      ::operator delete(c.data);
+  }
+
+  // Allocate bytes with the given alignment, which must be a power of
+  // two. If the current chunk is full, we continue with the next chunk
+  // that was kept from an earlier rewind or, if there is none that is
+  // large enough, insert a new one.
+  void* allocate(size_t bytes, size_t align=alignof(max_align_t)){
+    for (;;){
+      if (current < chunks.size()){
+        char* base = chunks[current].data;
+        size_t p = ((reinterpret_cast<uintptr_t>(base) + offset + align-1) & ~uintptr_t(align-1))
+          - reinterpret_cast<uintptr_t>(base);
+        if (p + bytes <= chunks[current].size){
+          offset = p + bytes;
+          return base + p;
+        }
+        if (current+1 < chunks.size() && chunks[current+1].size >= bytes+align){
+          current++;
+          offset = 0;
+          continue;
+        }
+        grow(current+1, bytes+align);
+        current++;
+        offset = 0;
+        continue;
+      }
+      grow(chunks.size(), bytes+align);
+      current = chunks.size()-1;
+      offset = 0;
+    }
+  }
+
+  // Allocate and default-initialize n objects of type T. Since memory
+  // is never freed individually, no destructors are called.
+  template<typename T>
+  T* allocate(size_t n){
+    static_assert(is_trivially_destructible<T>::value,
+                  "Arena memory is released without calling destructors.");
+    T* p = static_cast<T*>(allocate(n*sizeof(T), alignof(T)));
+    for (size_t i=0; i<n; i++)
+      new (p+i) T;
+    return p;
+  }
+
+  // Save and restore the state of the arena. Rewinding releases all
+  // memory allocated after the marker was taken.
+  Marker mark() const { return Marker{current, offset}; }
+  void rewind(const Marker& m){ current = m.chunk; offset = m.offset; }
+
+  // Release all memory but keep the chunks
+  void reset(){ current = 0; offset = 0; }
+
+  // Number of chunks and total number of bytes held by the arena
+  size_t num_chunks() const { return chunks.size(); }
+  size_t capacity() const {
+    size_t c = 0;
+    for (auto& chunk : chunks)
+      c += chunk.size;
+    return c;
+  }
+
+  // The arena of the calling thread
+  static Arena& local(){
+    static thread_local Arena arena;
+    return arena;
+  }
+
+private:
+  struct Chunk{
+    char*  data;
+    size_t size;
+  };
+
+  // Insert a new chunk of at least the given size at position pos
+  void grow(size_t pos, size_t size){
+    Chunk c;
+    c.size = size > chunksize ? size : chunksize;
+    c.data = static_cast<char*>(::operator new(c.size));
+    chunks.insert(chunks.begin()+pos, c);
+  }
+
+  // Minimum size of a chunk
+  size_t chunksize;
+
+  // Chunks of memory, the index of the chunk that is currently filled
+  // and the offset of the first free byte in it
+  vector<Chunk> chunks;
+  size_t current;
+  size_t offset;
+};
+
+// Marks an arena (by default the one of the calling thread) on
+// construction and rewinds it on destruction
+class ArenaScope{
+
+public:
+  explicit ArenaScope(Arena& arena=Arena::local())
+    : arena(arena), marker(arena.mark()){}
+
+  ArenaScope(const ArenaScope&) = delete;
+  ArenaScope& operator=(const ArenaScope&) = delete;
+
+  ~ArenaScope(){ arena.rewind(marker); }
+
+  // Allocate n objects of type T from the arena
+  template<typename T>
+  T* allocate(size_t n){ return arena.allocate<T>(n); }
+
+private:
+  Arena& arena;
+  Arena::Marker marker;
+};
+
+// Allocator for standard containers that draws memory from an arena.
+// Deallocation does nothing; the memory is released by rewinding the
+// arena, so the container must not outlive the enclosing ArenaScope.
+template<typename T>
+class ArenaAllocator{
+
+public:
+  typedef T value_type;
+
+  ArenaAllocator(Arena& arena=Arena::local()) noexcept : arena(&arena){}
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena){}
+
+  T* allocate(size_t n){
+    return static_cast<T*>(arena->allocate(n*sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, size_t) noexcept {}
+
+  // Pointer to the arena, public for the converting constructor
+  Arena* arena;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b){
+  return a.arena == b.arena;
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b){
+  return a.arena != b.arena;
+}
+
+#ifdef ARENA_HAS_PMR
+// Polymorphic memory resource on top of an arena, e.g., for
+// pmr::vector<double> v(n, &resource)
+class ArenaResource : public pmr::memory_resource{
+
+public:
+  explicit ArenaResource(Arena& arena=Arena::local()) : arena(arena){}
+
+private:
+  void* do_allocate(size_t bytes, size_t align) override {
+    return arena.allocate(bytes, align);
+  }
+
+  void do_deallocate(void*, size_t, size_t) override {}
+
+  bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+    auto o = dynamic_cast<const ArenaResource*>(&other);
+    return o != nullptr && &o->arena == &arena;
+  }
+
+  Arena& arena;
+};
+#endif
+
+#endif // ARENA_HPP
@@ -0,0 +1,200 @@
+/**
+ * \file FilonRule.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements a Filon-type quadrature rule for oscillatory
+ * integrals of the form
+ *
+ * \verbatim
+ * int_a^b f(x) cos(k*x) dx   or   int_a^b f(x) sin(k*x) dx
+ * \endverbatim
+ *
+ * The smooth factor f is interpolated by a polynomial at the n
+ * Gauss-Legendre points and the product with the oscillatory factor
+ * is integrated exactly. Writing the Lagrange basis polynomials in
+ * terms of Legendre polynomials P_m and using
+ *
+ * \verbatim
+ * int_{-1}^1 P_m(t) exp(i*omega*t) dt = 2 * i^m * j_m(omega)
+ * \endverbatim
+ *
+ * with the spherical Bessel functions j_m, the weights become
+ *
+ * \verbatim
+ * W_j(omega) = w_j * sum_{m=0}^{n-1} (2m+1) * i^m * j_m(omega) * P_m(t_j)
+ * \endverbatim
+ *
+ * For k=0 this reduces to the Gauss-Legendre rule. In contrast to the
+ * Gauss-Legendre rule, the error does not grow with the frequency k.
+ *
+ */
+
+#ifndef FILON_RULE_HPP
+#define FILON_RULE_HPP
+
+// Include header file for mathematical functions
+#include <cmath>
+
+// Include header files for numeric limits and the vector container
+#include <limits>
+#include <vector>
+
+// Include header files for Gauss-Legendre points of arbitrary order
+// and the scratch memory arena
+#include "Arena.hpp"
+#include "GaussJacobiRule.hpp"
+
+using namespace std;
+
+// Oscillatory factor of the integrand
+enum class FilonKind { Cosine, Sine };
+
+// Templated class with data type TData for all floating point data
+// and data type TIndex for all index type data
+template<typename TData=double, typename TIndex=int>
+class FilonRule{
+
+private:
+  // Number of quadrature points
+  TIndex N;
+
+  // Frequency and oscillatory factor
+  TData k;
+  FilonKind kind;
+
+  // Underlying Gauss-Legendre rule
+  GaussJacobiRule<TData,TIndex> legendre;
+
+  // Table (2m+1) * w_j * P_m(t_j) stored row-wise for m=0,...,N-1
+  vector<TData> P;
+
+public:
+  // Constructor
+  FilonRule(TIndex n, TData k, FilonKind kind=FilonKind::Cosine)
+    : N(n), k(k), kind(kind), legendre(n), P(n*n){
+
+    const TData* t = legendre.points();
+    const TData* w = legendre.weights();
+
+    // Three-term recurrence for the Legendre polynomials
+    for (TIndex j=0; j<N; j++){
+      TData p0 = TData(1), p1 = t[j];
+      for (TIndex m=0; m<N; m++){
+        TData pm = (m == 0 ? p0 : p1);
+        P[m*N+j] = TData(2*m+1)*w[j]*pm;
+        if (m > 0){
+          TData p2 = (TData(2*m+1)*t[j]*p1 - TData(m)*p0)/TData(m+1);
+          p0 = p1;
+          p1 = p2;
+        }
+      }
+    }
+  }
+
+  // Access to frequency and oscillatory factor
+  TData frequency() const { return k; }
+  FilonKind type() const { return kind; }
+
+  // Spherical Bessel functions j_0(z),...,j_{M-1}(z). Upward recurrence
+  // is only stable for m<|z|, so Miller's downward recurrence is used
+  // otherwise and normalized with the larger of j_0 and j_1.
+  static void sph_bessel(TData z, TIndex M, TData* j){
+    const TData az = abs(z);
+
+    if (az < TData(1e-3)){
+      // Taylor series j_m(z) = z^m/(2m+1)!! * (1 - z^2/(2(2m+3)) + ...)
+      TData zm = TData(1), df = TData(1);
+      for (TIndex m=0; m<M; m++){
+        df *= TData(2*m+1);
+        j[m] = zm/df*(TData(1) - az*az/TData(2*(2*m+3))
+                      + az*az*az*az/TData(8*(2*m+3)*(2*m+5)));
+        zm *= az;
+      }
+    } else {
+      const TData s = sin(az), c = cos(az);
+      const TData j0 = s/az, j1 = (s/az - c)/az;
+
+      if (az >= TData(M)){
+        // Stable upward recurrence
+        j[0] = j0;
+        if (M > 1) j[1] = j1;
+        for (TIndex m=2; m<M; m++)
+          j[m] = TData(2*m-1)/az*j[m-1] - j[m-2];
+      } else {
+        // Miller's downward recurrence
+        const TData big = sqrt(numeric_limits<TData>::max());
+        TIndex L = M + 16 + TIndex(az);
+        TData jp1 = TData(0), jc = TData(1)/big, c0 = TData(0), c1 = TData(0);
+        for (TIndex m=L; m>=1; m--){
+          TData jm1 = TData(2*m+1)/az*jc - jp1;
+          jp1 = jc;
+          jc  = jm1;
+          if (m-1 < M) j[m-1] = jm1;
+          if (m-1 == 1) c1 = jm1;
+          if (m-1 == 0) c0 = jm1;
+
+          // Rescale to prevent overflow
+          if (abs(jc) > big){
+            for (TIndex i=m-1; i<M; i++) j[i] /= big;
+            jc /= big; jp1 /= big; c0 /= big; c1 /= big;
+          }
+        }
+        const TData scale = (abs(j0) > abs(j1) ? j0/c0 : j1/c1);
+        for (TIndex m=0; m<M; m++)
+          j[m] *= scale;
+      }
+    }
+
+    // j_m(-z) = (-1)^m j_m(z)
+    if (z < TData(0))
+      for (TIndex m=1; m<M; m+=2)
+        j[m] = -j[m];
+  }
+
+  // Method that evaluates int_a^b f(x) cos(kx) dx or int_a^b f(x)
+  // sin(kx) dx. With x = c + h*t we obtain
+  //
+  // int_a^b f(x) exp(ikx) dx = h * exp(ikc) * sum_j W_j(kh) f(c+h*t_j)
+  //
+  // with W_j = A_j + i*B_j collecting the even and odd Legendre modes.
+  template<typename TFunc>
+  TData eval(TFunc f, TData a, TData b) const {
+    const TData h = (b-a)/TData(2);
+    const TData c = (a+b)/TData(2);
+    const TData* t = legendre.points();
+
+    // Spherical Bessel functions for omega=k*h; the scratch memory is
+    // taken from the thread-local arena
+    ArenaScope scope;
+    TData* jm = scope.allocate<TData>(N);
+    sph_bessel(k*h, N, jm);
+
+    // Coefficients i^m * j_m split into real (even m) and imaginary
+    // (odd m) parts
+    for (TIndex m=0; m<N; m++)
+      if ((m/2) % 2 == 1)
+        jm[m] = -jm[m];
+
+    const TData ckc = cos(k*c), skc = sin(k*c);
+    TData Int = TData(0);
+    for (TIndex j=0; j<N; j++){
+      TData A = TData(0), B = TData(0);
+      for (TIndex m=0; m<N; m+=2)
+        A += jm[m]*P[m*N+j];
+      for (TIndex m=1; m<N; m+=2)
+        B += jm[m]*P[m*N+j];
+
+      const TData fj = f(h * t[j] + c);
+      if (kind == FilonKind::Cosine)
+        Int += fj*(ckc*A - skc*B);
+      else
+        Int += fj*(skc*A + ckc*B);
+    }
+    return Int * h;
+  }
+};
+
+#endif // FILON_RULE_HPP
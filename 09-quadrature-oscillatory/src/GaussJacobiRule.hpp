@@ -0,0 +1,188 @@
+/**
+ * \file GaussJacobiRule.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements a one-dimensional Gauss-Jacobi quadrature
+ * rule for integrals with algebraic endpoint singularities
+ *
+ * \verbatim
+ * int_a^b (b-x)^alpha * (x-a)^beta * f(x) dx,   alpha, beta > -1
+ * \endverbatim
+ *
+ * The singular factor is absorbed into the weights so that only the
+ * smooth part f has to be evaluated. For alpha=beta=0 this is the
+ * Gauss-Legendre rule of class GaussRule, but for an arbitrary number
+ * of quadrature points.
+ *
+ */
+
+#ifndef GAUSS_JACOBI_RULE_HPP
+#define GAUSS_JACOBI_RULE_HPP
+
+// Include header file for mathematical functions
+#include <cmath>
+
+// Include header files for numeric limits and exceptions
+#include <limits>
+#include <stdexcept>
+
+// Include header file for the shared storage of quadrature tables
+#include "QuadratureTable.hpp"
+
+using namespace std;
+
+// Templated class with data type TData for all floating point data
+// and data type TIndex for all index type data
+template<typename TData=double, typename TIndex=int>
+class GaussJacobiRule{
+
+private:
+  // Number of quadrature points
+  TIndex N;
+
+  // Exponents of the weight function (1-t)^alpha * (1+t)^beta
+  TData alpha, beta;
+
+  // Shared table of quadrature points and weights on [-1,1]
+  typename QuadratureCache<TData,TIndex>::Table table;
+
+  // Quadrature points and weights on [-1,1] (owned by the table)
+  const TData *x;
+  const TData *w;
+
+public:
+  // Standard constructor: 3-pt Gauss-Legendre rule
+  GaussJacobiRule() : GaussJacobiRule(3){}
+
+  // Constructor: the table is taken from the cache or computed once
+  GaussJacobiRule(TIndex n, TData alpha=TData(0), TData beta=TData(0))
+    : N(n), alpha(alpha), beta(beta){
+
+    if (n < 1)
+      throw invalid_argument("Number of quadrature points must be positive.");
+    if (!(alpha > TData(-1)) || !(beta > TData(-1)))
+      throw invalid_argument("Jacobi exponents must be larger than -1.");
+
+    table = QuadratureCache<TData,TIndex>::get("jacobi", n, alpha, beta,
+                                                [=](QuadratureTable<TData,TIndex>& t){
+                                                  build(t, alpha, beta);
+                                                });
+    x = table->x;
+    w = table->w;
+  }
+
+  // The nodes are the zeros of the Jacobi polynomial P_n^(alpha,beta)
+  // which are computed by Newton's method starting from the asymptotic
+  // initial guesses given in Numerical Recipes (gaujac). The weights
+  // follow from the derivative of P_n.
+  static void build(QuadratureTable<TData,TIndex>& t, TData alpha, TData beta){
+    const TIndex n = t.N;
+    TData *x = t.x, *w = t.w;
+
+    const TData eps = TData(4)*numeric_limits<TData>::epsilon();
+    const TData ab  = alpha+beta;
+    TData z=TData(0), pp=TData(0), p2=TData(0), temp=TData(0);
+
+    for (TIndex i=0; i<n; i++){
+      // Initial guess for the i-th largest zero
+      if (i == 0){
+        TData an = alpha/TData(n), bn = beta/TData(n);
+        TData r1 = (TData(1)+alpha)*(TData(2.78)/(TData(4)+TData(n*n))+TData(0.768)*an/TData(n));
+        TData r2 = TData(1)+TData(1.48)*an+TData(0.96)*bn+TData(0.452)*an*an+TData(0.83)*an*bn;
+        z = TData(1)-r1/r2;
+      } else if (i == 1){
+        TData r1 = (TData(4.1)+alpha)/((TData(1)+alpha)*(TData(1)+TData(0.156)*alpha));
+        TData r2 = TData(1)+TData(0.06)*(TData(n)-TData(8))*(TData(1)+TData(0.12)*alpha)/TData(n);
+        TData r3 = TData(1)+TData(0.012)*beta*(TData(1)+TData(0.25)*abs(alpha))/TData(n);
+        z -= (TData(1)-z)*r1*r2*r3;
+      } else if (i == 2){
+        TData r1 = (TData(1.67)+TData(0.28)*alpha)/(TData(1)+TData(0.37)*alpha);
+        TData r2 = TData(1)+TData(0.22)*(TData(n)-TData(8))/TData(n);
+        TData r3 = TData(1)+TData(8)*beta/((TData(6.28)+beta)*TData(n*n));
+        z -= (x[0]-z)*r1*r2*r3;
+      } else if (i == n-2){
+        TData r1 = (TData(1)+TData(0.235)*beta)/(TData(0.766)+TData(0.119)*beta);
+        TData r2 = TData(1)/(TData(1)+TData(0.639)*(TData(n)-TData(4))/(TData(1)+TData(0.71)*(TData(n)-TData(4))));
+        TData r3 = TData(1)/(TData(1)+TData(20)*alpha/((TData(7.5)+alpha)*TData(n*n)));
+        z += (z-x[n-4])*r1*r2*r3;
+      } else if (i == n-1){
+        TData r1 = (TData(1)+TData(0.37)*beta)/(TData(1.67)+TData(0.28)*beta);
+        TData r2 = TData(1)/(TData(1)+TData(0.22)*(TData(n)-TData(8))/TData(n));
+        TData r3 = TData(1)/(TData(1)+TData(8)*alpha/((TData(6.28)+alpha)*TData(n*n)));
+        z += (z-x[n-3])*r1*r2*r3;
+      } else {
+        z = TData(3)*x[i-1]-TData(3)*x[i-2]+x[i-3];
+      }
+
+      // Newton iteration; the three-term recurrence yields
+      // p1=P_n(z) and p2=P_{n-1}(z), from which the derivative pp is
+      // computed
+      for (int it=0; it<100; it++){
+        temp = TData(2)+ab;
+        TData p1 = (alpha-beta+temp*z)/TData(2);
+        p2 = TData(1);
+        for (TIndex j=2; j<=n; j++){
+          TData p3 = p2;
+          p2 = p1;
+          temp = TData(2*j)+ab;
+          TData aj = TData(2*j)*(TData(j)+ab)*(temp-TData(2));
+          TData bj = (temp-TData(1))*(alpha*alpha-beta*beta+temp*(temp-TData(2))*z);
+          TData cj = TData(2)*(TData(j-1)+alpha)*(TData(j-1)+beta)*temp;
+          p1 = (bj*p2-cj*p3)/aj;
+        }
+        pp = (TData(n)*(alpha-beta-temp*z)*p1
+              +TData(2)*(TData(n)+alpha)*(TData(n)+beta)*p2)/(temp*(TData(1)-z*z));
+        TData z1 = z;
+        z = z1-p1/pp;
+        if (abs(z-z1) <= eps)
+          break;
+      }
+
+      // The weights are known up to the common factor
+      // Gamma(n+alpha)*Gamma(n+beta)/(Gamma(n+1)*Gamma(n+alpha+beta+1))
+      x[i] = z;
+      w[i] = temp/(pp*p2);
+    }
+
+    // Evaluating the common factor by lgamma of large arguments loses
+    // several digits, so the weights are scaled such that their sum
+    // equals int_-1^1 (1-t)^alpha (1+t)^beta dt instead
+    TData sum = TData(0);
+    for (TIndex i=0; i<n; i++)
+      sum += w[i];
+    const TData mu0 = pow(TData(2),ab+TData(1))
+      *exp(lgamma(alpha+TData(1))+lgamma(beta+TData(1))-lgamma(ab+TData(2)));
+    for (TIndex i=0; i<n; i++)
+      w[i] *= mu0/sum;
+  }
+
+  // Access to the number of points and the points and weights on [-1,1]
+  TIndex size() const { return N; }
+  const TData* points() const { return x; }
+  const TData* weights() const { return w; }
+
+  // Access to the padded number of points and the interleaved layout
+  // (x_0,w_0,x_1,w_1,...), see QuadratureTable.hpp
+  TIndex padded_size() const { return table->NP; }
+  const TData* interleaved() const { return table->xw; }
+
+  // Method that evaluates int_a^b (b-x)^alpha * (x-a)^beta * f(x) dx.
+  // With x = (a+b)/2 + (b-a)/2*t we have b-x = (b-a)/2*(1-t) and x-a =
+  // (b-a)/2*(1+t), so that the weights are scaled by
+  // ((b-a)/2)^(1+alpha+beta).
+  template<typename TFunc>
+  TData eval(TFunc f, TData a, TData b) const {
+    const TData h = (b-a)/TData(2);
+    const TData c = (a+b)/TData(2);
+
+    TData Int = TData(0);
+    for (TIndex k=0; k<N; k++)
+      Int += w[k]*f(h * x[k] + c);
+    return Int * pow(h, TData(1)+alpha+beta);
+  }
+};
+
+#endif // GAUSS_JACOBI_RULE_HPP
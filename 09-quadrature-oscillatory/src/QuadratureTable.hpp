@@ -0,0 +1,134 @@
+/**
+ * \file QuadratureTable.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the storage of quadrature points and weights
+ * that is shared by all Gauss-type rules with computed nodes, and a
+ * process-wide cache of such tables. Computing the nodes by Newton's
+ * method costs O(n^2) operations, so every table is built once per
+ * rule family, number of points and parameters and then shared by
+ * all rule objects via reference counting (std::shared_ptr).
+ *
+ * The points and weights are stored in 64-byte aligned arrays that are
+ * padded with zero points and weights, see AlignedArray.hpp. In
+ * addition, every table provides the interleaved layout
+ * (x_0,w_0,x_1,w_1,...) for kernels that prefer to load a point and
+ * its weight from the same cache line.
+ *
+ */
+
+#ifndef QUADRATURE_TABLE_HPP
+#define QUADRATURE_TABLE_HPP
+
+// Include header files for the map container and tuples
+#include <map>
+#include <tuple>
+
+// Include header files for strings, smart pointers and mutexes
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Include header file for aligned and padded arrays
+#include "AlignedArray.hpp"
+
+using namespace std;
+
+// Templated class with data type TData for all floating point data
+// and data type TIndex for all index type data
+template<typename TData=double, typename TIndex=int>
+class QuadratureTable{
+
+private:
+  // Aligned storage of points, weights and interleaved pairs; these
+  // members are declared first so that they are constructed before
+  // the pointers below are initialized
+  AlignedArray<TData> xdata, wdata, xwdata;
+
+public:
+  // Number of quadrature points without and with padding
+  TIndex N, NP;
+
+  // Quadrature points
+  TData *x;
+
+  // Quadrature weights
+  TData *w;
+
+  // Interleaved points and weights (x_0,w_0,...,x_{NP-1},w_{NP-1})
+  TData *xw;
+
+  // Constructor: allocate memory for n points and weights
+  QuadratureTable(TIndex n)
+    : xdata(n), wdata(n), xwdata(2*xdata.padded_size()),
+      N(n), NP(TIndex(xdata.padded_size())),
+      x(xdata.data()), w(wdata.data()), xw(xwdata.data()){}
+
+  // Tables are shared by pointer, so they must not be copied
+  QuadratureTable(const QuadratureTable&) = delete;
+  QuadratureTable& operator=(const QuadratureTable&) = delete;
+
+  // Copy the points and weights into the interleaved layout; this is
+  // called by QuadratureCache once the table has been built
+  void interleave(){
+    for (TIndex k=0; k<NP; k++){
+      xw[2*k]   = x[k];
+      xw[2*k+1] = w[k];
+    }
+  }
+};
+
+// Cache of quadrature tables identified by the name of the rule
+// family, the number of points and up to two real parameters
+template<typename TData=double, typename TIndex=int>
+class QuadratureCache{
+
+public:
+  typedef shared_ptr<const QuadratureTable<TData,TIndex> > Table;
+
+  // Return the table for the given key. If it does not exist yet, it
+  // is created and filled by the callable build(QuadratureTable&).
+  // The lock is held while building so that concurrent first calls
+  // do not compute the same table twice.
+  template<typename TBuild>
+  static Table get(const string& family, TIndex n, TData p1, TData p2, TBuild build){
+    lock_guard<mutex> lock(guard());
+
+    auto key = make_tuple(family, n, p1, p2);
+    auto it  = tables().find(key);
+    if (it != tables().end())
+      return it->second;
+
+    shared_ptr<QuadratureTable<TData,TIndex> > table(new QuadratureTable<TData,TIndex>(n));
+    build(*table);
+    table->interleave();
+    tables()[key] = table;
+    return table;
+  }
+
+  // Number of cached tables
+  static size_t size(){
+    lock_guard<mutex> lock(guard());
+    return tables().size();
+  }
+
+private:
+  typedef tuple<string, TIndex, TData, TData> Key;
+
+  // Function-local statics avoid the need for out-of-class
+  // definitions of static data members of a class template
+  static map<Key, Table>& tables(){
+    static map<Key, Table> t;
+    return t;
+  }
+
+  static mutex& guard(){
+    static mutex m;
+    return m;
+  }
+};
+
+#endif // QUADRATURE_TABLE_HPP
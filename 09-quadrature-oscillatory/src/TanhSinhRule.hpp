@@ -0,0 +1,113 @@
+/**
+ * \file TanhSinhRule.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements the double-exponential (tanh-sinh)
+ * quadrature rule of Takahasi and Mori. The substitution
+ *
+ * \verbatim
+ * t = tanh(pi/2 * sinh(s))
+ * \endverbatim
+ *
+ * maps [-1,1] onto the real line and makes the transformed integrand
+ * decay double-exponentially, so that the trapezoidal rule with step
+ * size h converges exponentially even for integrable endpoint
+ * singularities like 1/sqrt(x) or log(x). No function value at the
+ * end points a and b is ever requested.
+ *
+ */
+
+#ifndef TANH_SINH_RULE_HPP
+#define TANH_SINH_RULE_HPP
+
+// Include header file for mathematical functions
+#include <cmath>
+
+// Include header files for numeric limits and exceptions
+#include <limits>
+#include <stdexcept>
+
+// Include header file for aligned and padded arrays
+#include "AlignedArray.hpp"
+
+using namespace std;
+
+// Templated class with data type TData for all floating point data
+// and data type TIndex for all index type data
+template<typename TData=double, typename TIndex=int>
+class TanhSinhRule{
+
+private:
+  // Number of quadrature points in each half, i.e. the rule has 2*M+1
+  // points in total
+  TIndex M;
+
+  // Distance of the points from the end points, i.e. 1-|t_k|, and
+  // weights for s_k = k*h, k=0,...,M. Storing the distance instead of
+  // t_k avoids the cancellation in 1-t_k near the end points. Both
+  // arrays are 64-byte aligned and padded with zeros.
+  AlignedArray<TData> d;
+  AlignedArray<TData> w;
+
+public:
+  // Standard constructor
+  TanhSinhRule() : TanhSinhRule(31){}
+
+  // Constructor for a rule with (about) n points. The truncation
+  // point s_max is chosen such that 1-|t| has dropped to eps^2, which
+  // is sufficient even for integrands that behave like 1/sqrt(1-|t|).
+  TanhSinhRule(TIndex n) : M(n/2), d(n/2+1), w(n/2+1){
+    if (n < 3)
+      throw invalid_argument("Tanh-sinh rule needs at least 3 points.");
+
+    const TData pi_2 = TData(2)*atan(TData(1));
+    const TData eps  = numeric_limits<TData>::epsilon();
+    const TData smax = asinh(log(TData(2)/(eps*eps))/(TData(2)*pi_2));
+    const TData h    = smax/TData(M);
+
+    for (TIndex k=0; k<=M; k++){
+      const TData s  = TData(k)*h;
+      const TData u  = pi_2*sinh(s);
+      const TData ch = cosh(u);
+
+      // 1 - tanh(u) = exp(-u)/cosh(u)
+      d[k] = exp(-u)/ch;
+      w[k] = h*pi_2*cosh(s)/(ch*ch);
+    }
+  }
+
+  // Quadrature rules own their memory, so they must not be copied
+  TanhSinhRule(const TanhSinhRule&) = delete;
+  TanhSinhRule& operator=(const TanhSinhRule&) = delete;
+
+  // Number of quadrature points
+  TIndex size() const { return 2*M+1; }
+
+  // Method that evaluates the integral of f over [a,b]. The points
+  // are computed as a+h*d_k and b-h*d_k; points that round to an end
+  // point are skipped since their weight is far below the precision.
+  // The centre point k=0 is only counted once. For b < a the integral
+  // is the negated one over [b,a], as for GaussRule.
+  template<typename TFunc>
+  TData eval(TFunc f, TData a, TData b) const {
+    if (b < a)
+      return -eval(f, b, a);
+    const TData h = (b-a)/TData(2);
+
+    TData Int = TData(0);
+    for (TIndex k=0; k<=M; k++){
+      const TData xl = a + h*d[k];
+      const TData xr = b - h*d[k];
+      if (xl > a && xl < b)
+        Int += w[k]*f(xl);
+      if (k > 0 && xr > a && xr < b)
+        Int += w[k]*f(xr);
+    }
+    return Int * h;
+  }
+};
+
+#endif // TANH_SINH_RULE_HPP
@@ -0,0 +1,119 @@
+/**
+ * \file quadrature-oscillatory.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we compare the Gauss-Legendre rule with specialized
+ * quadrature rules for integrands that are hard for polynomial-based
+ * rules:
+ *
+ * (a) oscillatory integrands f(x)*cos(k*x) -> Filon-type rule
+ * (b) algebraic end point singularities    -> Gauss-Jacobi rule
+ * (c) general end point singularities      -> tanh-sinh rule
+ *
+ * All rules share the interface of class GaussRule, i.e. they are
+ * constructed once and evaluated by eval(f, a, b).
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header file for standard utility library
+#include <cstdlib>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for quadrature rules
+#include "FilonRule.hpp"
+#include "GaussJacobiRule.hpp"
+#include "TanhSinhRule.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of quadrature points from command line arguments
+  IndexType n = 10;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    n = atoi(argv[1]);
+    break;
+  default:
+    cout << "Usage: quadrature-oscillatory" << endl;
+    cout << "       quadrature-oscillatory n" << endl;
+    exit(-1);
+  }
+
+  cout.precision(15);
+
+  // (a) int_0^{2pi} exp(-x/2) cos(kx) dx for increasing frequency k
+  {
+    const DataType a=0.0, b=2.0*M_PI, al=-0.5;
+    GaussJacobiRule<DataType,IndexType> GR(n); // Gauss-Legendre
+
+    cout << "int_0^2pi exp(-x/2)*cos(k*x) dx with n=" << n << " points:" << endl;
+    for (DataType k : {1.0, 10.0, 100.0, 1000.0}){
+      FilonRule<DataType,IndexType> FR(n, k, FilonKind::Cosine);
+
+      // exp(al*x)*(al*cos(kx) + k*sin(kx))/(al^2+k^2)
+      auto F = [=](DataType x){ return exp(al*x)*(al*cos(k*x)+k*sin(k*x))/(al*al+k*k); };
+      DataType exact = F(b)-F(a);
+
+      DataType I_gauss = GR.eval([=](DataType x){ return exp(al*x)*cos(k*x); }, a, b);
+      DataType I_filon = FR.eval([=](DataType x){ return exp(al*x); }, a, b);
+
+      cout << "  k=" << k << ": exact " << exact
+           << ", Gauss error " << abs(I_gauss-exact)
+           << ", Filon error " << abs(I_filon-exact) << endl;
+    }
+  }
+
+  // (b) int_0^1 cos(x)/sqrt(x) dx = 2*int_0^1 cos(u^2) du (Fresnel integral)
+  {
+    const DataType exact = 1.809048475800544;
+    GaussJacobiRule<DataType,IndexType> GR(n); // Gauss-Legendre
+    GaussJacobiRule<DataType,IndexType> GJ(n, 0.0, -0.5);
+    TanhSinhRule<DataType,IndexType> TS(4*n+1);
+
+    DataType I_gauss = GR.eval([](DataType x){ return cos(x)/sqrt(x); }, 0.0, 1.0);
+    DataType I_jacobi = GJ.eval([](DataType x){ return cos(x); }, 0.0, 1.0);
+    DataType I_ts = TS.eval([](DataType x){ return cos(x)/sqrt(x); }, 0.0, 1.0);
+
+    cout << "int_0^1 cos(x)/sqrt(x) dx:" << endl;
+    cout << "  Gauss-Legendre (" << n << " pts) error: " << abs(I_gauss-exact) << endl;
+    cout << "  Gauss-Jacobi   (" << n << " pts) error: " << abs(I_jacobi-exact) << endl;
+    cout << "  tanh-sinh      (" << TS.size() << " pts) error: " << abs(I_ts-exact) << endl;
+  }
+
+  // (c) int_0^1 log(x)/sqrt(x) dx = -4
+  {
+    const DataType exact = -4.0;
+    GaussJacobiRule<DataType,IndexType> GR(n); // Gauss-Legendre
+    TanhSinhRule<DataType,IndexType> TS(4*n+1);
+
+    DataType I_gauss = GR.eval([](DataType x){ return log(x)/sqrt(x); }, 0.0, 1.0);
+    DataType I_ts = TS.eval([](DataType x){ return log(x)/sqrt(x); }, 0.0, 1.0);
+
+    cout << "int_0^1 log(x)/sqrt(x) dx:" << endl;
+    cout << "  Gauss-Legendre (" << n << " pts) error: " << abs(I_gauss-exact) << endl;
+    cout << "  tanh-sinh      (" << TS.size() << " pts) error: " << abs(I_ts-exact) << endl;
+  }
+
+  // End program
+  return 0;
+}
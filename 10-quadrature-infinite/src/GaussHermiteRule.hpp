@@ -0,0 +1,169 @@
+/**
+ * \file GaussHermiteRule.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements a one-dimensional Gauss-Hermite quadrature
+ * rule for the infinite interval (-infinity,infinity)
+ *
+ * \verbatim
+ * int_-inf^inf f(x) dx = s * int_-inf^inf f(m+s*t) dt
+ *                     ~= s * sum_k w_k * exp(t_k^2) * f(m+s*t_k)
+ * \endverbatim
+ *
+ * where t_k and w_k are the nodes and weights for the weight function
+ * exp(-t^2), and m and s are the centre and the width of the
+ * integrand. The rule is exact if f(m+s*t) is a polynomial of degree
+ * 2n-1 times exp(-t^2).
+ *
+ */
+
+#ifndef GAUSS_HERMITE_RULE_HPP
+#define GAUSS_HERMITE_RULE_HPP
+
+// Include header file for mathematical functions
+#include <cmath>
+
+// Include header files for numeric limits and exceptions
+#include <limits>
+#include <stdexcept>
+
+// Include header file for the shared storage of quadrature tables
+#include "QuadratureTable.hpp"
+
+using namespace std;
+
+// Templated class with data type TData for all floating point data
+// and data type TIndex for all index type data
+template<typename TData=double, typename TIndex=int>
+class GaussHermiteRule{
+
+private:
+  // Number of quadrature points
+  TIndex N;
+
+  // Centre and width of the integrand
+  TData centre, scale;
+
+  // Shared tables of quadrature points, weights and modified weights
+  // w_k * exp(t_k^2)
+  typename QuadratureCache<TData,TIndex>::Table table, modified;
+
+  // Quadrature points and (modified) weights (owned by the tables)
+  const TData *x;
+  const TData *w;
+  const TData *wm;
+
+public:
+  // Standard constructor
+  GaussHermiteRule() : GaussHermiteRule(10){}
+
+  // Constructor: the tables are taken from the cache or computed once
+  GaussHermiteRule(TIndex n, TData centre=TData(0), TData scale=TData(1))
+    : N(n), centre(centre), scale(scale){
+
+    if (n < 1)
+      throw invalid_argument("Number of quadrature points must be positive.");
+
+    table = QuadratureCache<TData,TIndex>::get("hermite", n, TData(0), TData(0), build);
+    x = table->x;
+    w = table->w;
+
+    // exp(t_k^2) overflows for large n, so the modified weights are
+    // computed as exp(log(w_k) + t_k^2)
+    auto tab = table;
+    modified = QuadratureCache<TData,TIndex>::get("hermite-modified", n, TData(0), TData(0),
+                                                   [=](QuadratureTable<TData,TIndex>& t){
+                                                     for (TIndex k=0; k<t.N; k++){
+                                                       t.x[k] = tab->x[k];
+                                                       t.w[k] = exp(log(tab->w[k]) + tab->x[k]*tab->x[k]);
+                                                     }
+                                                   });
+    wm = modified->w;
+  }
+
+  // The nodes are the zeros of the Hermite polynomial H_n which are
+  // computed by Newton's method starting from the asymptotic initial
+  // guesses given in Numerical Recipes (gauher). The recurrence is
+  // written for the orthonormal polynomials to avoid overflow. The
+  // nodes are symmetric, so only the positive half is computed.
+  static void build(QuadratureTable<TData,TIndex>& t){
+    const TIndex n = t.N;
+    TData *x = t.x, *w = t.w;
+
+    // pi^(-1/4)
+    const TData pim4 = TData(0.7511255444649425);
+    const TData eps  = TData(4)*numeric_limits<TData>::epsilon();
+    TData z=TData(0), pp=TData(0);
+
+    for (TIndex i=0; i<(n+1)/2; i++){
+      // Initial guess for the i-th largest zero
+      if (i == 0)
+        z = sqrt(TData(2*n+1))-TData(1.85575)*pow(TData(2*n+1),TData(-0.16667));
+      else if (i == 1)
+        z -= TData(1.14)*pow(TData(n),TData(0.426))/z;
+      else if (i == 2)
+        z = TData(1.86)*z-TData(0.86)*x[0];
+      else if (i == 3)
+        z = TData(1.91)*z-TData(0.91)*x[1];
+      else
+        z = TData(2)*z-x[i-2];
+
+      // Newton iteration
+      for (int it=0; it<100; it++){
+        TData p1 = pim4, p2 = TData(0);
+        for (TIndex j=0; j<n; j++){
+          TData p3 = p2;
+          p2 = p1;
+          p1 = z*sqrt(TData(2)/TData(j+1))*p2-sqrt(TData(j)/TData(j+1))*p3;
+        }
+        pp = sqrt(TData(2*n))*p2;
+        TData z1 = z;
+        z = z1-p1/pp;
+        if (abs(z-z1) <= eps*(TData(1)+abs(z)))
+          break;
+      }
+
+      x[i] = z;
+      x[n-1-i] = -z;
+      w[i] = TData(2)/(pp*pp);
+      w[n-1-i] = w[i];
+    }
+  }
+
+  // Access to the number of points and the points and weights
+  TIndex size() const { return N; }
+  const TData* points() const { return x; }
+  const TData* weights() const { return w; }
+
+  // Method that evaluates int_a^b f(x) dx with a=-infinity and
+  // b=infinity
+  template<typename TFunc>
+  TData eval(TFunc f, TData a, TData b) const {
+    const TData inf = numeric_limits<TData>::infinity();
+    if (a != -inf || b != inf)
+      throw invalid_argument("Gauss-Hermite rule needs the interval (-infinity,infinity).");
+
+    TData Int = TData(0);
+    for (TIndex k=0; k<N; k++)
+      Int += wm[k]*f(centre + scale*x[k]);
+    return Int * scale;
+  }
+
+  // Method that evaluates the weighted integral
+  //
+  // int_-inf^inf exp(-((x-m)/s)^2) * f(x) dx
+  //
+  // where only the smooth part f has to be provided
+  template<typename TFunc>
+  TData eval_weighted(TFunc f) const {
+    TData Int = TData(0);
+    for (TIndex k=0; k<N; k++)
+      Int += w[k]*f(centre + scale*x[k]);
+    return Int * scale;
+  }
+};
+
+#endif // GAUSS_HERMITE_RULE_HPP
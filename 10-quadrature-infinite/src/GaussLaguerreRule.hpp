@@ -0,0 +1,193 @@
+/**
+ * \file GaussLaguerreRule.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements a one-dimensional generalized Gauss-Laguerre
+ * quadrature rule for the semi-infinite interval [a,infinity)
+ *
+ * \verbatim
+ * int_a^inf f(x) dx = s * int_0^inf f(a+s*t) dt
+ *                  ~= s * sum_k w_k * exp(t_k) * t_k^(-alpha) * f(a+s*t_k)
+ * \endverbatim
+ *
+ * where t_k and w_k are the nodes and weights for the weight function
+ * t^alpha * exp(-t) and s is a length scale of the integrand. The rule
+ * is exact if f(a+s*t) is a polynomial of degree 2n-1 times
+ * t^alpha * exp(-t).
+ *
+ */
+
+#ifndef GAUSS_LAGUERRE_RULE_HPP
+#define GAUSS_LAGUERRE_RULE_HPP
+
+// Include header file for mathematical functions
+#include <cmath>
+
+// Include header files for numeric limits and exceptions
+#include <limits>
+#include <stdexcept>
+
+// Include header file for the shared storage of quadrature tables
+#include "QuadratureTable.hpp"
+
+using namespace std;
+
+// Templated class with data type TData for all floating point data
+// and data type TIndex for all index type data
+template<typename TData=double, typename TIndex=int>
+class GaussLaguerreRule{
+
+private:
+  // Number of quadrature points
+  TIndex N;
+
+  // Exponent of the weight function t^alpha * exp(-t) and length scale
+  TData alpha, scale;
+
+  // Shared table of quadrature points and weights on [0,infinity)
+  typename QuadratureCache<TData,TIndex>::Table table;
+
+  // Quadrature points and weights (owned by the table)
+  const TData *x;
+  const TData *w;
+
+  // Modified weights w_k * exp(t_k) * t_k^(-alpha) for integrands
+  // without the weight function (owned by a second table)
+  typename QuadratureCache<TData,TIndex>::Table modified;
+  const TData *wm;
+
+public:
+  // Standard constructor
+  GaussLaguerreRule() : GaussLaguerreRule(10){}
+
+  // Constructor: the tables are taken from the cache or computed once
+  GaussLaguerreRule(TIndex n, TData alpha=TData(0), TData scale=TData(1))
+    : N(n), alpha(alpha), scale(scale){
+
+    if (n < 1)
+      throw invalid_argument("Number of quadrature points must be positive.");
+    if (!(alpha > TData(-1)))
+      throw invalid_argument("Laguerre exponent must be larger than -1.");
+
+    table = QuadratureCache<TData,TIndex>::get("laguerre", n, alpha, TData(0),
+                                                [=](QuadratureTable<TData,TIndex>& t){
+                                                  build(t, alpha);
+                                                });
+    x = table->x;
+    w = table->w;
+
+    // exp(t_k) overflows for large n, so the modified weights are
+    // computed as exp(log(w_k) + t_k - alpha*log(t_k))
+    auto tab = table;
+    modified = QuadratureCache<TData,TIndex>::get("laguerre-modified", n, alpha, TData(0),
+                                                   [=](QuadratureTable<TData,TIndex>& t){
+                                                     for (TIndex k=0; k<t.N; k++){
+                                                       t.x[k] = tab->x[k];
+                                                       t.w[k] = exp(log(tab->w[k]) + tab->x[k]
+                                                                    - alpha*log(tab->x[k]));
+                                                     }
+                                                   });
+    wm = modified->w;
+  }
+
+  // The nodes are the zeros of the generalized Laguerre polynomial
+  // L_n^(alpha) which are computed by Newton's method starting from
+  // the asymptotic initial guesses given in Numerical Recipes (gaulag)
+  static void build(QuadratureTable<TData,TIndex>& t, TData alpha){
+    const TIndex n = t.N;
+    TData *x = t.x, *w = t.w;
+
+    const TData eps = TData(4)*numeric_limits<TData>::epsilon();
+    TData z=TData(0), pp=TData(0), p2=TData(0);
+
+    for (TIndex i=0; i<n; i++){
+      // Initial guess for the i-th smallest zero
+      if (i == 0){
+        z = (TData(1)+alpha)*(TData(3)+TData(0.92)*alpha)
+          /(TData(1)+TData(2.4)*TData(n)+TData(1.8)*alpha);
+      } else if (i == 1){
+        z += (TData(15)+TData(6.25)*alpha)/(TData(1)+TData(0.9)*alpha+TData(2.5)*TData(n));
+      } else {
+        TData ai = TData(i-1);
+        z += ((TData(1)+TData(2.55)*ai)/(TData(1.9)*ai)
+              +TData(1.26)*ai*alpha/(TData(1)+TData(3.5)*ai))*(z-x[i-2])/(TData(1)+TData(0.3)*alpha);
+      }
+
+      // Newton iteration; the three-term recurrence yields p1=L_n(z)
+      // and p2=L_{n-1}(z), from which the derivative pp is computed
+      for (int it=0; it<100; it++){
+        TData p1 = TData(1);
+        p2 = TData(0);
+        for (TIndex j=0; j<n; j++){
+          TData p3 = p2;
+          p2 = p1;
+          p1 = ((TData(2*j+1)+alpha-z)*p2-(TData(j)+alpha)*p3)/TData(j+1);
+        }
+        pp = (TData(n)*p1-(TData(n)+alpha)*p2)/z;
+        TData z1 = z;
+        z = z1-p1/pp;
+        if (abs(z-z1) <= eps*abs(z))
+          break;
+      }
+
+      // The weights are known up to the common factor
+      // Gamma(n+alpha)/Gamma(n)
+      x[i] = z;
+      w[i] = -TData(1)/(pp*TData(n)*p2);
+    }
+
+    // Scale the weights to their sum int_0^inf t^alpha exp(-t) dt =
+    // Gamma(alpha+1), as in GaussJacobiRule
+    TData sum = TData(0);
+    for (TIndex i=0; i<n; i++)
+      sum += w[i];
+    const TData mu0 = tgamma(alpha+TData(1));
+    for (TIndex i=0; i<n; i++)
+      w[i] *= mu0/sum;
+  }
+
+  // Access to the number of points and the points and weights
+  TIndex size() const { return N; }
+  const TData* points() const { return x; }
+  const TData* weights() const { return w; }
+
+  // Method that evaluates int_a^b f(x) dx, where exactly one of the
+  // bounds must be infinite. For b=-infinity we integrate over
+  // (-infinity,a] by reflection.
+  template<typename TFunc>
+  TData eval(TFunc f, TData a, TData b) const {
+    const TData inf = numeric_limits<TData>::infinity();
+
+    if (isfinite(a) && b == inf){
+      TData Int = TData(0);
+      for (TIndex k=0; k<N; k++)
+        Int += wm[k]*f(a + scale*x[k]);
+      return Int * scale;
+    }
+    if (a == -inf && isfinite(b)){
+      TData Int = TData(0);
+      for (TIndex k=0; k<N; k++)
+        Int += wm[k]*f(b - scale*x[k]);
+      return Int * scale;
+    }
+    throw invalid_argument("Gauss-Laguerre rule needs exactly one infinite bound.");
+  }
+
+  // Method that evaluates the weighted integral
+  //
+  // int_a^inf ((x-a)/s)^alpha * exp(-(x-a)/s) * f(x) dx
+  //
+  // where only the smooth part f has to be provided
+  template<typename TFunc>
+  TData eval_weighted(TFunc f, TData a) const {
+    TData Int = TData(0);
+    for (TIndex k=0; k<N; k++)
+      Int += w[k]*f(a + scale*x[k]);
+    return Int * scale;
+  }
+};
+
+#endif // GAUSS_LAGUERRE_RULE_HPP
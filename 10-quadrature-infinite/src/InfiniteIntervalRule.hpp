@@ -0,0 +1,84 @@
+/**
+ * \file InfiniteIntervalRule.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class wraps any quadrature rule for finite intervals with the
+ * interface eval(f, a, b) and applies it to (semi-)infinite intervals
+ * by means of the variable transformations
+ *
+ * \verbatim
+ * [a,inf):    x = a + s*t/(1-t),      dx = s/(1-t)^2 dt,           t in [0,1)
+ * (-inf,b]:   x = b - s*t/(1-t),      dx = s/(1-t)^2 dt,           t in [0,1)
+ * (-inf,inf): x = m + s*t/(1-t^2),    dx = s*(1+t^2)/(1-t^2)^2 dt, t in (-1,1)
+ * \endverbatim
+ *
+ * Finite intervals are passed to the wrapped rule unchanged. Rules
+ * that never evaluate the integrand at the end points (Gauss-Legendre,
+ * Gauss-Jacobi, tanh-sinh) are required since the transformed
+ * integrand is singular at t=1. In contrast to Gauss-Laguerre and
+ * Gauss-Hermite rules this also works for algebraically decaying
+ * integrands like 1/(1+x^2).
+ *
+ */
+
+#ifndef INFINITE_INTERVAL_RULE_HPP
+#define INFINITE_INTERVAL_RULE_HPP
+
+// Include header file for mathematical functions
+#include <cmath>
+
+// Include header file for numeric limits
+#include <limits>
+
+using namespace std;
+
+// Templated class with the type TRule of the wrapped quadrature rule
+// and data type TData for all floating point data
+template<typename TRule, typename TData=double>
+class InfiniteIntervalRule{
+
+private:
+  // Wrapped rule for finite intervals (not owned)
+  const TRule& rule;
+
+  // Centre and length scale of the integrand
+  TData centre, scale;
+
+public:
+  // Constructor
+  InfiniteIntervalRule(const TRule& rule, TData centre=TData(0), TData scale=TData(1))
+    : rule(rule), centre(centre), scale(scale){}
+
+  // Method that evaluates int_a^b f(x) dx for finite or infinite bounds
+  template<typename TFunc>
+  TData eval(TFunc f, TData a, TData b) const {
+    const TData inf = numeric_limits<TData>::infinity();
+    const TData one = TData(1);
+    const TData s = scale, m = centre;
+
+    if (a == -inf && b == inf)
+      return rule.eval([&](TData t){
+          const TData d = one-t*t;
+          return f(m + s*t/d) * s*(one+t*t)/(d*d);
+        }, -one, one);
+
+    if (b == inf)
+      return rule.eval([&](TData t){
+          const TData d = one-t;
+          return f(a + s*t/d) * s/(d*d);
+        }, TData(0), one);
+
+    if (a == -inf)
+      return rule.eval([&](TData t){
+          const TData d = one-t;
+          return f(b - s*t/d) * s/(d*d);
+        }, TData(0), one);
+
+    return rule.eval(f, a, b);
+  }
+};
+
+#endif // INFINITE_INTERVAL_RULE_HPP
@@ -0,0 +1,153 @@
+/**
+ * \file quadrature-infinite.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we integrate over semi-infinite and infinite
+ * intervals. Instead of truncating the interval to [0,L] and using a
+ * composite Gauss rule with many panels, we use
+ *
+ * (a) Gauss-Laguerre rules for [a,infinity)
+ * (b) Gauss-Hermite rules for (-infinity,infinity)
+ * (c) variable transformations applied to rules for finite intervals
+ *
+ * All rules obtain their points and weights from a common cache, so
+ * that constructing the same rule again is cheap.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header file for standard utility library
+#include <cstdlib>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header file for numeric limits
+#include <limits>
+
+// Include header files for quadrature rules
+#include "GaussRule.hpp"
+#include "GaussJacobiRule.hpp"
+#include "GaussLaguerreRule.hpp"
+#include "GaussHermiteRule.hpp"
+#include "TanhSinhRule.hpp"
+#include "InfiniteIntervalRule.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// Composite n-pt Gauss rule over [a,b] with the given number of
+// panels; this is what we had to do so far after truncating the
+// infinite interval
+template<typename TFunc>
+DataType composite(TFunc f, DataType a, DataType b, IndexType n, IndexType panels){
+  GaussRule<DataType,IndexType> GR(n);
+  DataType h = (b-a)/panels, Int = 0.0;
+  for (IndexType p=0; p<panels; p++)
+    Int += GR.eval(f, a+p*h, a+(p+1)*h);
+  return Int;
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of quadrature points from command line arguments
+  IndexType n = 20;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    n = atoi(argv[1]);
+    break;
+  default:
+    cout << "Usage: quadrature-infinite" << endl;
+    cout << "       quadrature-infinite n" << endl;
+    exit(-1);
+  }
+
+  const DataType inf = numeric_limits<DataType>::infinity();
+  cout.precision(15);
+
+  // (a) int_0^inf exp(-x)*cos(x) dx = 1/2
+  {
+    auto f = [](DataType x){ return exp(-x)*cos(x); };
+    const DataType exact = 0.5;
+
+    GaussLaguerreRule<DataType,IndexType> GL(n);
+    DataType I_trunc = composite(f, 0.0, 40.0, 10, 100);
+    DataType I_lag = GL.eval(f, 0.0, inf);
+    DataType I_lagw = GL.eval_weighted([](DataType x){ return cos(x); }, 0.0);
+
+    cout << "int_0^inf exp(-x)*cos(x) dx:" << endl;
+    cout << "  truncated composite Gauss (1000 evals) error: " << abs(I_trunc-exact) << endl;
+    cout << "  Gauss-Laguerre            (" << n << " evals) error: " << abs(I_lag-exact) << endl;
+    cout << "  Gauss-Laguerre weighted   (" << n << " evals) error: " << abs(I_lagw-exact) << endl;
+  }
+
+  // (b) int_-inf^inf exp(-x^2)*cos(x) dx = sqrt(pi)*exp(-1/4)
+  {
+    auto f = [](DataType x){ return exp(-x*x)*cos(x); };
+    const DataType exact = sqrt(M_PI)*exp(-0.25);
+
+    GaussHermiteRule<DataType,IndexType> GH(n);
+    DataType I_trunc = composite(f, -10.0, 10.0, 10, 100);
+    DataType I_her = GH.eval(f, -inf, inf);
+    DataType I_herw = GH.eval_weighted([](DataType x){ return cos(x); });
+
+    cout << "int_-inf^inf exp(-x^2)*cos(x) dx:" << endl;
+    cout << "  truncated composite Gauss (1000 evals) error: " << abs(I_trunc-exact) << endl;
+    cout << "  Gauss-Hermite             (" << n << " evals) error: " << abs(I_her-exact) << endl;
+    cout << "  Gauss-Hermite weighted    (" << n << " evals) error: " << abs(I_herw-exact) << endl;
+  }
+
+  // (c) Algebraic decay: int_0^inf 1/(1+x^2) dx = pi/2 and
+  // int_-inf^inf 1/(1+x^2)^2 dx = pi/2
+  {
+    auto f = [](DataType x){ return 1.0/(1.0+x*x); };
+    auto g = [](DataType x){ return 1.0/((1.0+x*x)*(1.0+x*x)); };
+    const DataType exact = M_PI/2.0;
+
+    GaussLaguerreRule<DataType,IndexType> GL(n);
+    GaussJacobiRule<DataType,IndexType> GJ(n); // Gauss-Legendre
+    TanhSinhRule<DataType,IndexType> TS(2*n+1);
+    InfiniteIntervalRule<GaussJacobiRule<DataType,IndexType>,DataType> IGJ(GJ);
+    InfiniteIntervalRule<TanhSinhRule<DataType,IndexType>,DataType> ITS(TS);
+
+    cout << "int_0^inf 1/(1+x^2) dx:" << endl;
+    cout << "  truncated composite Gauss (1000 evals) error: "
+         << abs(composite(f, 0.0, 1000.0, 10, 100)-exact) << endl;
+    cout << "  Gauss-Laguerre            (" << n << " evals) error: "
+         << abs(GL.eval(f, 0.0, inf)-exact) << endl;
+    cout << "  transformed Gauss-Legendre(" << n << " evals) error: "
+         << abs(IGJ.eval(f, 0.0, inf)-exact) << endl;
+    cout << "  transformed tanh-sinh     (" << TS.size() << " evals) error: "
+         << abs(ITS.eval(f, 0.0, inf)-exact) << endl;
+
+    cout << "int_-inf^inf 1/(1+x^2)^2 dx:" << endl;
+    cout << "  transformed Gauss-Legendre(" << n << " evals) error: "
+         << abs(IGJ.eval(g, -inf, inf)-exact) << endl;
+    cout << "  transformed tanh-sinh     (" << TS.size() << " evals) error: "
+         << abs(ITS.eval(g, -inf, inf)-exact) << endl;
+  }
+
+  // Rules of the same family and order share their tables, so
+  // constructing a rule for the second time does not add a table
+  GaussLaguerreRule<DataType,IndexType> GL2(n);
+  cout << "Number of cached quadrature tables: "
+       << QuadratureCache<DataType,IndexType>::size() << endl;
+
+  // End program
+  return 0;
+}
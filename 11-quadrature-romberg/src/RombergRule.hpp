@@ -0,0 +1,123 @@
+/**
+ * \file RombergRule.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements Romberg integration, i.e. Richardson
+ * extrapolation of the composite trapezoidal rule T(h) for successive
+ * halvings h, h/2, h/4, ... of the panel width
+ *
+ * \verbatim
+ * R(k,0) = T(h/2^k)
+ * R(k,j) = R(k,j-1) + (R(k,j-1) - R(k-1,j-1)) / (4^j - 1)
+ * \endverbatim
+ *
+ * The first extrapolation column R(k,1) is the composite Simpson rule
+ * with 2^k subintervals (2^(k-1) Simpson panels) as used in
+ * 04-quadrature-static, and every further column removes one more
+ * power of h^2 from the error. Since the points of level k-1 are a
+ * subset of the points of level k, each refinement only evaluates the
+ * integrand at the 2^(k-1) new midpoints. The iteration stops as soon
+ * as two successive diagonal entries agree up to the tolerance.
+ *
+ */
+
+#ifndef ROMBERG_RULE_HPP
+#define ROMBERG_RULE_HPP
+
+// Include header file for mathematical functions
+#include <cmath>
+
+// Include header files for exceptions and the swap function
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+// Templated class with data type TData for all floating point data
+// and data type TIndex for all index type data
+template<typename TData=double, typename TIndex=int>
+class RombergRule{
+
+private:
+  // Absolute tolerance and maximum number of halvings
+  TData tol;
+  TIndex maxlevel;
+
+  // Statistics of the last call to eval
+  mutable TIndex nlevels, nevals;
+  mutable TData errest;
+
+public:
+  // Upper bound for maxlevel. Level k needs 2^k+1 evaluations of the
+  // integrand, so this is no restriction in practice, and it allows to
+  // keep the rows of the Richardson table on the stack.
+  static const int maxlevels = 30;
+
+  // Standard constructor
+  RombergRule() : RombergRule(TData(1e-10)){}
+
+  // Constructor
+  RombergRule(TData tol, TIndex maxlevel=20)
+    : tol(tol), maxlevel(maxlevel), nlevels(0), nevals(0), errest(TData(0)){
+    if (maxlevel < 2)
+      throw invalid_argument("Romberg integration needs at least two levels.");
+    if (maxlevel > maxlevels)
+      throw invalid_argument("Romberg integration supports at most 30 levels.");
+  }
+
+  // Statistics of the last call to eval: number of levels, number of
+  // function evaluations and estimated error
+  TIndex levels() const { return nlevels; }
+  TIndex evaluations() const { return nevals; }
+  TData error() const { return errest; }
+
+  // Method that evaluates the integral of f over [a,b]
+  template<typename TFunc>
+  TData eval(TFunc f, TData a, TData b) const {
+    // Two rows of the Richardson table suffice; they are swapped by
+    // pointer so that eval never allocates memory on the heap
+    TData rows[2][maxlevels+1];
+    TData *prev = rows[0], *curr = rows[1];
+
+    // Level 0: trapezoidal rule with a single panel
+    TData h = b-a;
+    prev[0] = h/TData(2) * (f(a) + f(b));
+    nevals = 2;
+
+    TIndex nnew = 1;
+    for (TIndex k=1; k<=maxlevel; k++){
+      // Trapezoidal rule with 2^k panels reuses T(2h) and adds the
+      // 2^(k-1) new midpoints
+      h /= TData(2);
+      TData sum = TData(0);
+      for (TIndex i=0; i<nnew; i++)
+        sum += f(a + TData(2*i+1)*h);
+      nevals += nnew;
+      nnew *= 2;
+      curr[0] = prev[0]/TData(2) + h*sum;
+
+      // Richardson extrapolation
+      TData factor = TData(1);
+      for (TIndex j=1; j<=k; j++){
+        factor *= TData(4);
+        curr[j] = curr[j-1] + (curr[j-1]-prev[j-1])/(factor-TData(1));
+      }
+
+      errest  = abs(curr[k]-prev[k-1]);
+      nlevels = k;
+      if (k >= 2 && errest <= tol)
+        return curr[k];
+
+      swap(prev, curr);
+    }
+
+    // No convergence within maxlevel halvings: return the best
+    // estimate, the caller can check error()
+    return prev[maxlevel];
+  }
+};
+
+#endif // ROMBERG_RULE_HPP
@@ -0,0 +1,97 @@
+/**
+ * \file quadrature-romberg.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we extend the composite Simpson rule from
+ * 04-quadrature-static by Romberg integration. Instead of prescribing
+ * the number of panels n, we prescribe a tolerance and keep halving
+ * the panel width until the extrapolated values have converged.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header file for standard utility library
+#include <cstdlib>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header file for Romberg integration
+#include "RombergRule.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// Composite Simpson's rule with n panels as in 04-quadrature-static
+// (evaluating each interior panel boundary only once)
+template<typename TFunc>
+DataType simpson(TFunc f, DataType a, DataType b, IndexType n){
+  DataType h = (b-a)/n, Int = f(a) + f(b);
+  for (IndexType k=1; k<=n; k++)
+    Int += 4.0*f(a+(k-0.5)*h) + (k<n ? 2.0*f(a+k*h) : 0.0);
+  return h/6.0 * Int;
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get tolerance and interval from command line arguments
+  DataType tol=1e-12, a=0.0, b=1.0;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    tol = atof(argv[1]);
+    break;
+  case 4:
+    tol = atof(argv[1]);
+    a = atof(argv[2]);
+    b = atof(argv[3]);
+    break;
+  default:
+    cout << "Usage: quadrature-romberg" << endl;
+    cout << "       quadrature-romberg tol" << endl;
+    cout << "       quadrature-romberg tol a b" << endl;
+    exit(-1);
+  }
+
+  // Count the function evaluations of cos(x)
+  IndexType count = 0;
+  auto f = [&count](DataType x){ count++; return cos(x); };
+  const DataType exact = sin(b)-sin(a);
+
+  RombergRule<DataType,IndexType> R(tol);
+  DataType IntR = R.eval(f, a, b);
+  IndexType countR = count;
+
+  // Composite Simpson with the same number of function evaluations
+  // (2n+1 for n panels)
+  count = 0;
+  DataType IntS = simpson(f, a, b, (countR-1)/2);
+  IndexType countS = count;
+
+  // Output
+  cout.precision(15);
+  cout << "Numerical integration of cos(x) over [" << a << "," << b << "] with tol="
+       << tol << ":" << endl;
+  cout << "Romberg integration:      " << IntR << " (" << R.levels() << " levels, "
+       << countR << " evaluations, estimated error " << R.error()
+       << ", error " << abs(IntR-exact) << ")" << endl;
+  cout << "Composite Simpson's rule: " << IntS << " (" << countS
+       << " evaluations, error " << abs(IntS-exact) << ")" << endl;
+
+  // End program
+  return 0;
+}
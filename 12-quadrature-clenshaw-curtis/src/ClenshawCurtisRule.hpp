@@ -0,0 +1,246 @@
+/**
+ * \file ClenshawCurtisRule.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements the Clenshaw-Curtis and Fejer quadrature
+ * rules on the Chebyshev points
+ *
+ * \verbatim
+ * Clenshaw-Curtis: x_k = cos(k*pi/n),       k=0,...,n   (n+1 points)
+ * Fejer type 2:    x_k = cos(k*pi/n),       k=1,...,n-1 (n-1 points)
+ * Fejer type 1:    x_k = cos((k+1/2)*pi/n), k=0,...,n-1 (n points)
+ * \endverbatim
+ *
+ * The weights are computed in O(n log n) operations as the inverse
+ * discrete Fourier transform of explicitly known vectors, see
+ * J. Waldvogel, Fast construction of the Fejer and Clenshaw-Curtis
+ * quadrature rules, BIT 46 (2006) 195-202. For Clenshaw-Curtis and
+ * Fejer type 2 these vectors are real and even, so that the real FFT
+ * suffices.
+ *
+ * In contrast to Gauss rules, the Clenshaw-Curtis points for n are a
+ * subset of those for 2n. The method eval_nested exploits this by
+ * doubling n until two successive results agree, evaluating the
+ * integrand only at the new points on every level.
+ *
+ */
+
+#ifndef CLENSHAW_CURTIS_RULE_HPP
+#define CLENSHAW_CURTIS_RULE_HPP
+
+// Include header files for complex numbers and mathematical functions
+#include <cmath>
+#include <complex>
+
+// Include header files for exceptions, strings and the vector container
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Include header files for the FFT, the scratch memory arena and the
+// shared storage of quadrature tables
+#include "Arena.hpp"
+#include "FFT.hpp"
+#include "QuadratureTable.hpp"
+
+using namespace std;
+
+// Variants of the rule
+enum class ClenshawCurtisKind { ClenshawCurtis, Fejer1, Fejer2 };
+
+// Templated class with data type TData for all floating point data
+// and data type TIndex for all index type data
+template<typename TData=double, typename TIndex=int>
+class ClenshawCurtisRule{
+
+private:
+  // Number of subintervals n (a power of two) and variant
+  TIndex n;
+  ClenshawCurtisKind kind;
+
+  // Shared table of quadrature points and weights on [-1,1]
+  typename QuadratureCache<TData,TIndex>::Table table;
+
+  // Statistics of the last call to eval_nested
+  mutable TIndex nlevels, nevals;
+  mutable TData errest;
+
+  // Return the (cached) table for n subintervals
+  static typename QuadratureCache<TData,TIndex>::Table
+  get_table(TIndex n, ClenshawCurtisKind kind){
+    static const char* names[] = {"clenshaw-curtis", "fejer1", "fejer2"};
+    TIndex npts = (kind == ClenshawCurtisKind::ClenshawCurtis ? n+1 :
+                   kind == ClenshawCurtisKind::Fejer1 ? n : n-1);
+    return QuadratureCache<TData,TIndex>::get(names[int(kind)], npts, TData(0), TData(0),
+                                              [=](QuadratureTable<TData,TIndex>& t){
+                                                build(t, n, kind);
+                                              });
+  }
+
+public:
+  // Standard constructor
+  ClenshawCurtisRule() : ClenshawCurtisRule(16){}
+
+  // Constructor for n subintervals
+  ClenshawCurtisRule(TIndex n, ClenshawCurtisKind kind=ClenshawCurtisKind::ClenshawCurtis)
+    : n(n), kind(kind), nlevels(0), nevals(0), errest(TData(0)){
+    if (!is_power_of_two(n) || n < 2)
+      throw invalid_argument("Number of subintervals must be a power of two larger than one.");
+    table = get_table(n, kind);
+  }
+
+  // Compute points and weights following Waldvogel (2006)
+  static void build(QuadratureTable<TData,TIndex>& t, TIndex n, ClenshawCurtisKind kind){
+    const TData pi = TData(4)*atan(TData(1));
+    const TIndex l = n/2;
+
+    if (kind == ClenshawCurtisKind::Fejer1){
+      // v_k = 2*exp(i*pi*k/n)/(1-4k^2) for k=0,...,n/2-1, zero for
+      // k=n/2 and v_{n-k} = conj(v_k)
+      vector<complex<TData> > v(n, complex<TData>(TData(0)));
+      for (TIndex k=0; k<l; k++){
+        v[k] = TData(2)*polar(TData(1), pi*TData(k)/TData(n))/(TData(1)-TData(4*k*k));
+        if (k > 0)
+          v[n-k] = conj(v[k]);
+      }
+      fft(v.data(), n, true);
+      for (TIndex k=0; k<n; k++){
+        t.x[k] = cos((TData(k)+TData(0.5))*pi/TData(n));
+        t.w[k] = real(v[k])/TData(n);
+      }
+      return;
+    }
+
+    // v_k = 2/(1-4k^2) for k=0,...,n/2-1, v_{n/2} = -2/(n-1) and
+    // v_{n-k} = v_k yield the Fejer type 2 weights
+    vector<TData> v(n);
+    for (TIndex k=0; k<l; k++){
+      v[k] = TData(2)/TData(1-4*k*k);
+      if (k > 0)
+        v[n-k] = v[k];
+    }
+    v[l] = TData(-2)/TData(n-1);
+
+    // Correction for Clenshaw-Curtis: g_k = -w0 for all k except
+    // g_{n/2} = (2n-1)*w0 with w0 = 1/(n^2-1)
+    if (kind == ClenshawCurtisKind::ClenshawCurtis){
+      const TData w0 = TData(1)/TData(n*n-1);
+      for (TIndex k=0; k<n; k++)
+        v[k] -= w0;
+      v[l] += TData(2*n)*w0;
+    }
+
+    // Inverse DFT of a real even vector equals the real part of its
+    // forward DFT divided by n, which is provided by the real FFT
+    vector<complex<TData> > V(l+1);
+    rfft(v.data(), V.data(), n);
+
+    if (kind == ClenshawCurtisKind::ClenshawCurtis){
+      for (TIndex k=0; k<=n; k++){
+        const TIndex kk = (k <= l ? k : n-k);
+        t.x[k] = cos(TData(k)*pi/TData(n));
+        t.w[k] = real(V[kk])/TData(n);
+      }
+      // The end points share the weight w_0 = 1/(n^2-1)
+      t.w[0] = t.w[n] = TData(1)/TData(n*n-1);
+    } else {
+      for (TIndex k=1; k<n; k++){
+        const TIndex kk = (k <= l ? k : n-k);
+        t.x[k-1] = cos(TData(k)*pi/TData(n));
+        t.w[k-1] = real(V[kk])/TData(n);
+      }
+    }
+  }
+
+  // Access to the number of points and the points and weights on [-1,1]
+  TIndex size() const { return table->N; }
+  const TData* points() const { return table->x; }
+  const TData* weights() const { return table->w; }
+
+  // Access to the padded number of points and the interleaved layout
+  // (x_0,w_0,x_1,w_1,...), see QuadratureTable.hpp
+  TIndex padded_size() const { return table->NP; }
+  const TData* interleaved() const { return table->xw; }
+
+  // Statistics of the last call to eval_nested: number of levels,
+  // number of function evaluations and estimated error
+  TIndex levels() const { return nlevels; }
+  TIndex evaluations() const { return nevals; }
+  TData error() const { return errest; }
+
+  // Method that evaluates the integral of f over [a,b]
+  template<typename TFunc>
+  TData eval(TFunc f, TData a, TData b) const {
+    const TData h = (b-a)/TData(2);
+    const TData c = (a+b)/TData(2);
+    const TData *x = table->x, *w = table->w;
+
+    TData Int = TData(0);
+    for (TIndex k=0; k<table->N; k++)
+      Int += w[k]*f(h * x[k] + c);
+    return Int * h;
+  }
+
+  // Method that evaluates the integral of f over [a,b] with nested
+  // Clenshaw-Curtis rules, starting from the number of subintervals
+  // of this rule and doubling it until two successive results differ
+  // by at most tol or nmax is reached. Since cos(k*pi/n) =
+  // cos(2k*pi/2n), the values of level n are the even entries of
+  // level 2n and are reused. The function values are stored in the
+  // thread-local arena, which is rewound on return.
+  template<typename TFunc>
+  TData eval_nested(TFunc f, TData a, TData b, TData tol, TIndex nmax=TIndex(1) << 16) const {
+    if (kind != ClenshawCurtisKind::ClenshawCurtis)
+      throw invalid_argument("Nested evaluation requires the Clenshaw-Curtis variant.");
+
+    const TData h = (b-a)/TData(2);
+    const TData c = (a+b)/TData(2);
+
+    // Function values at the points of the current level
+    TIndex m = n;
+    typename QuadratureCache<TData,TIndex>::Table tab = get_table(m, kind);
+    ArenaScope scope;
+    TData* fv = scope.allocate<TData>(m+1);
+    for (TIndex k=0; k<=m; k++)
+      fv[k] = f(h * tab->x[k] + c);
+    nevals = m+1;
+    nlevels = 1;
+
+    TData Int = TData(0);
+    for (TIndex k=0; k<=m; k++)
+      Int += tab->w[k]*fv[k];
+    Int *= h;
+    errest = TData(0);
+
+    while (2*m <= nmax){
+      // Double the number of subintervals and evaluate f only at the
+      // new (odd) points
+      tab = get_table(2*m, kind);
+      TData* fnew = scope.allocate<TData>(2*m+1);
+      for (TIndex k=0; k<=m; k++)
+        fnew[2*k] = fv[k];
+      for (TIndex k=0; k<m; k++)
+        fnew[2*k+1] = f(h * tab->x[2*k+1] + c);
+      nevals += m;
+      m *= 2;
+      nlevels++;
+      fv = fnew;
+
+      TData IntNew = TData(0);
+      for (TIndex k=0; k<=m; k++)
+        IntNew += tab->w[k]*fv[k];
+      IntNew *= h;
+
+      errest = abs(IntNew-Int);
+      Int = IntNew;
+      if (errest <= tol)
+        break;
+    }
+    return Int;
+  }
+};
+
+#endif // CLENSHAW_CURTIS_RULE_HPP
@@ -0,0 +1,106 @@
+/**
+ * \file FFT.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the radix-2 fast Fourier transform
+ *
+ * \verbatim
+ * X_k = sum_{j=0}^{n-1} x_j * exp(-2*pi*i*j*k/n),   k=0,...,n-1
+ * \endverbatim
+ *
+ * for complex data and, by packing the even and odd samples into the
+ * real and imaginary parts of a complex sequence of half the length,
+ * for real data. Both transforms need O(n log n) operations; the
+ * length n must be a power of two.
+ *
+ */
+
+#ifndef FFT_HPP
+#define FFT_HPP
+
+// Include header files for complex numbers and mathematical functions
+#include <cmath>
+#include <complex>
+
+// Include header files for exceptions and the vector container
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+// Check if n is a power of two
+template<typename TIndex>
+bool is_power_of_two(TIndex n){
+  return n > 0 && (n & (n-1)) == 0;
+}
+
+// In-place complex FFT of length n. For inverse=true the sign of the
+// exponent is flipped; the result is NOT scaled by 1/n.
+template<typename TData, typename TIndex>
+void fft(complex<TData>* x, TIndex n, bool inverse=false){
+  if (!is_power_of_two(n))
+    throw invalid_argument("FFT length must be a power of two.");
+
+  // Bit-reversal permutation
+  for (TIndex i=1, j=0; i<n; i++){
+    TIndex bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j)
+      swap(x[i], x[j]);
+  }
+
+  // Twiddle factors exp(-+2*pi*i*k/n), k=0,...,n/2-1, are computed
+  // directly (rather than by repeated multiplication) for accuracy
+  const TData pi = TData(4)*atan(TData(1));
+  const TData sign = inverse ? TData(1) : TData(-1);
+  vector<complex<TData> > twiddle(n/2);
+  for (TIndex k=0; k<n/2; k++)
+    twiddle[k] = complex<TData>(cos(TData(2)*pi*TData(k)/TData(n)),
+                                sign*sin(TData(2)*pi*TData(k)/TData(n)));
+
+  // Iterative Cooley-Tukey butterflies
+  for (TIndex len=2; len<=n; len <<= 1){
+    const TIndex stride = n/len;
+    for (TIndex i=0; i<n; i+=len)
+      for (TIndex k=0; k<len/2; k++){
+        complex<TData> u = x[i+k];
+        complex<TData> v = x[i+k+len/2]*twiddle[k*stride];
+        x[i+k]       = u+v;
+        x[i+k+len/2] = u-v;
+      }
+  }
+}
+
+// FFT of the real sequence x of length n. Since X_{n-k} = conj(X_k),
+// only the n/2+1 coefficients X_0,...,X_{n/2} are returned in X. The
+// even and odd samples are transformed together as one complex
+// sequence z_j = x_{2j} + i*x_{2j+1} of length n/2 and separated
+// afterwards.
+template<typename TData, typename TIndex>
+void rfft(const TData* x, complex<TData>* X, TIndex n){
+  if (!is_power_of_two(n) || n < 2)
+    throw invalid_argument("Real FFT length must be a power of two larger than one.");
+
+  const TIndex m = n/2;
+  vector<complex<TData> > z(m);
+  for (TIndex j=0; j<m; j++)
+    z[j] = complex<TData>(x[2*j], x[2*j+1]);
+  fft(z.data(), m);
+
+  const TData pi = TData(4)*atan(TData(1));
+  for (TIndex k=0; k<=m; k++){
+    const complex<TData> zk  = z[k % m];
+    const complex<TData> zmk = conj(z[(m-k) % m]);
+    const complex<TData> even = (zk + zmk)/TData(2);
+    const complex<TData> odd  = (zk - zmk)*complex<TData>(TData(0), TData(-0.5));
+    const complex<TData> tw(cos(pi*TData(k)/TData(m)), -sin(pi*TData(k)/TData(m)));
+    X[k] = even + tw*odd;
+  }
+}
+
+#endif // FFT_HPP
@@ -0,0 +1,112 @@
+/**
+ * \file quadrature-clenshaw-curtis.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we use Clenshaw-Curtis and Fejer quadrature rules,
+ * whose weights are computed by the fast Fourier transform. Since the
+ * Clenshaw-Curtis points are nested, the number of points can be
+ * doubled until convergence without wasting a single evaluation of
+ * the integrand, which is not possible with Gauss rules.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header file for standard utility library
+#include <cstdlib>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for quadrature rules
+#include "ClenshawCurtisRule.hpp"
+#include "GaussJacobiRule.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get tolerance and interval from command line arguments
+  DataType tol=1e-13, a=0.0, b=2.0*M_PI;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    tol = atof(argv[1]);
+    break;
+  case 4:
+    tol = atof(argv[1]);
+    a = atof(argv[2]);
+    b = atof(argv[3]);
+    break;
+  default:
+    cout << "Usage: quadrature-clenshaw-curtis" << endl;
+    cout << "       quadrature-clenshaw-curtis tol" << endl;
+    cout << "       quadrature-clenshaw-curtis tol a b" << endl;
+    exit(-1);
+  }
+
+  cout.precision(15);
+
+  // Count the function evaluations of exp(cos(x))
+  IndexType count = 0;
+  auto f = [&count](DataType x){ count++; return exp(cos(x)); };
+
+  // Reference value from a 60-pt Gauss-Legendre rule on 8 panels
+  GaussJacobiRule<DataType,IndexType> GL60(60);
+  DataType exact = 0.0;
+  for (int p=0; p<8; p++)
+    exact += GL60.eval([](DataType x){ return exp(cos(x)); },
+                       a+p*(b-a)/8.0, a+(p+1)*(b-a)/8.0);
+
+  // (a) Fixed rules with n=32 subintervals
+  cout << "Numerical integration of exp(cos(x)) over [" << a << "," << b << "]:" << endl;
+  for (auto kind : {ClenshawCurtisKind::ClenshawCurtis,
+                    ClenshawCurtisKind::Fejer1,
+                    ClenshawCurtisKind::Fejer2}){
+    ClenshawCurtisRule<DataType,IndexType> CC(32, kind);
+    count = 0;
+    DataType Int = CC.eval(f, a, b);
+    cout << (kind == ClenshawCurtisKind::ClenshawCurtis ? "Clenshaw-Curtis: " :
+             kind == ClenshawCurtisKind::Fejer1 ? "Fejer type 1:    " : "Fejer type 2:    ")
+         << Int << " (" << count << " evaluations, error " << abs(Int-exact) << ")" << endl;
+  }
+
+  // (b) Nested Clenshaw-Curtis rules, starting with n=2
+  ClenshawCurtisRule<DataType,IndexType> CC2(2);
+  count = 0;
+  DataType IntN = CC2.eval_nested(f, a, b, tol);
+  cout << "Nested Clenshaw-Curtis: " << IntN << " (" << CC2.levels() << " levels, "
+       << count << " evaluations, estimated error " << CC2.error()
+       << ", error " << abs(IntN-exact) << ")" << endl;
+
+  // (c) Increasing the number of Gauss points n=2,4,8,... until the
+  // same tolerance is met throws away all previous evaluations
+  count = 0;
+  DataType IntG = 0.0, IntOld = 0.0;
+  for (IndexType n=2; n<=1024; n*=2){
+    GaussJacobiRule<DataType,IndexType> GL(n);
+    IntG = GL.eval(f, a, b);
+    if (n > 2 && abs(IntG-IntOld) <= tol)
+      break;
+    IntOld = IntG;
+  }
+  cout << "Doubling Gauss-Legendre: " << IntG << " (" << count
+       << " evaluations, error " << abs(IntG-exact) << ")" << endl;
+
+  // End program
+  return 0;
+}
@@ -0,0 +1,196 @@
+/**
+ * \file CompositeRule.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class turns a quadrature rule on [-1,1] into composite, batch
+ * and adaptive integration routines
+ *
+ * \verbatim
+ * eval:          int_a^b f(x) dx on p panels of equal length
+ * eval_batch:    int_{a_i}^{b_i} f(x) dx for m intervals at once
+ * eval_adaptive: int_a^b f(x) dx by adaptive bisection
+ * \endverbatim
+ *
+ * All scratch memory (mapped points, function values and the stack of
+ * intervals) is taken from the thread-local arena, see Arena.hpp, so
+ * that repeated calls do not allocate memory on the heap once the
+ * arena has grown to the required size. The mapped points and the
+ * function values are kept in separate arrays so that the loops that
+ * compute them can be vectorized by the compiler.
+ *
+ * The rule only needs to provide size(), points() and weights(), e.g.,
+ * GaussRule from 06-quadrature-oop1-templates or GaussJacobiRule and
+ * ClenshawCurtisRule from 09 and 12.
+ *
+ */
+
+#ifndef COMPOSITE_RULE_HPP
+#define COMPOSITE_RULE_HPP
+
+// Include header file for mathematical functions
+#include <cmath>
+
+// Include header file for exceptions
+#include <stdexcept>
+
+// Include header file for the scratch memory arena
+#include "Arena.hpp"
+
+using namespace std;
+
+// Templated class with the type TRule of the underlying rule, data
+// type TData for all floating point data and data type TIndex for
+// all index type data
+template<typename TRule, typename TData=double, typename TIndex=int>
+class CompositeRule{
+
+private:
+  // Underlying rule on [-1,1]; rules own their tables and cannot be
+  // copied, so we only keep a reference
+  const TRule& rule;
+
+  // Statistics of the last call to eval_adaptive
+  mutable TIndex nintervals, nevals;
+  mutable TData errest;
+
+  // Map the points of the rule to the panels [a+i*H,a+(i+1)*H] for
+  // i=0,...,p-1 and store them consecutively in X
+  void map_points(TData* X, TData a, TData H, TIndex p) const {
+    const TIndex N = rule.size();
+    const TData* x = rule.points();
+    const TData h = H/TData(2);
+    for (TIndex i=0; i<p; i++){
+      const TData c = a + (TData(i)+TData(0.5))*H;
+      for (TIndex k=0; k<N; k++)
+        X[i*N+k] = h * x[k] + c;
+    }
+  }
+
+  // Weighted sum of the N function values in F
+  TData weighted_sum(const TData* F) const {
+    const TIndex N = rule.size();
+    const TData* w = rule.weights();
+    TData Int = TData(0);
+    for (TIndex k=0; k<N; k++)
+      Int += w[k]*F[k];
+    return Int;
+  }
+
+  // Apply the rule once on [a,b] using the scratch arrays X and F
+  template<typename TFunc>
+  TData apply(TFunc& f, TData a, TData b, TData* X, TData* F) const {
+    const TIndex N = rule.size();
+    map_points(X, a, b-a, 1);
+    for (TIndex k=0; k<N; k++)
+      F[k] = f(X[k]);
+    nevals += N;
+    return weighted_sum(F) * (b-a)/TData(2);
+  }
+
+public:
+  // Constructor
+  CompositeRule(const TRule& rule)
+    : rule(rule), nintervals(0), nevals(0), errest(TData(0)){}
+
+  // Statistics of the last call to eval_adaptive: number of accepted
+  // intervals, number of function evaluations and estimated error
+  TIndex intervals() const { return nintervals; }
+  TIndex evaluations() const { return nevals; }
+  TData error() const { return errest; }
+
+  // Method that evaluates the integral of f over [a,b] divided into p
+  // panels of equal length
+  template<typename TFunc>
+  TData eval(TFunc f, TData a, TData b, TIndex p=1) const {
+    if (p < 1)
+      throw invalid_argument("Number of panels must be positive.");
+
+    const TIndex N = rule.size();
+    const TData H = (b-a)/TData(p);
+
+    ArenaScope scope;
+    TData* X = scope.allocate<TData>(p*N);
+    TData* F = scope.allocate<TData>(p*N);
+
+    map_points(X, a, H, p);
+    for (TIndex i=0; i<p*N; i++)
+      F[i] = f(X[i]);
+
+    TData Int = TData(0);
+    for (TIndex i=0; i<p; i++)
+      Int += weighted_sum(F+i*N);
+    return Int * H/TData(2);
+  }
+
+  // Method that evaluates the integrals of f over the m intervals
+  // [a[i],b[i]] and stores them in result[i]
+  template<typename TFunc>
+  void eval_batch(TFunc f, const TData* a, const TData* b, TData* result, TIndex m) const {
+    const TIndex N = rule.size();
+
+    ArenaScope scope;
+    TData* X = scope.allocate<TData>(m*N);
+    TData* F = scope.allocate<TData>(m*N);
+
+    for (TIndex i=0; i<m; i++)
+      map_points(X+i*N, a[i], b[i]-a[i], 1);
+    for (TIndex i=0; i<m*N; i++)
+      F[i] = f(X[i]);
+    for (TIndex i=0; i<m; i++)
+      result[i] = weighted_sum(F+i*N) * (b[i]-a[i])/TData(2);
+  }
+
+  // Method that evaluates the integral of f over [a,b] by adaptive
+  // bisection. An interval is accepted if the rule applied to it and
+  // the sum over its two halves differ by at most tol times its
+  // relative length, otherwise both halves are processed in turn. The
+  // intervals are processed depth-first, so the stack never holds more
+  // than maxdepth+1 intervals.
+  template<typename TFunc>
+  TData eval_adaptive(TFunc f, TData a, TData b, TData tol, TIndex maxdepth=30) const {
+    struct Interval{
+      TData a, b, Int;
+      TIndex depth;
+    };
+
+    const TIndex N = rule.size();
+
+    ArenaScope scope;
+    Interval* stack = scope.allocate<Interval>(maxdepth+1);
+    TData* X = scope.allocate<TData>(N);
+    TData* F = scope.allocate<TData>(N);
+
+    nintervals = 0;
+    nevals = 0;
+    errest = TData(0);
+
+    TIndex top = 0;
+    stack[top++] = Interval{a, b, apply(f, a, b, X, F), 0};
+
+    TData Int = TData(0);
+    while (top > 0){
+      Interval I = stack[--top];
+      const TData m = (I.a+I.b)/TData(2);
+      const TData left  = apply(f, I.a, m, X, F);
+      const TData right = apply(f, m, I.b, X, F);
+      const TData err = abs(left+right-I.Int);
+
+      if (err <= tol*abs((I.b-I.a)/(b-a)) || I.depth == maxdepth){
+        Int += left+right;
+        errest += err;
+        nintervals++;
+      } else {
+        // Push the right half first so that the left half is
+        // processed next
+        stack[top++] = Interval{m, I.b, right, I.depth+1};
+        stack[top++] = Interval{I.a, m, left, I.depth+1};
+      }
+    }
+    return Int;
+  }
+};
+
+#endif // COMPOSITE_RULE_HPP
@@ -0,0 +1,161 @@
+/**
+ * \file quadrature-arena.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version all integration routines take their scratch memory
+ * from a thread-local arena instead of calling new[] and delete[] (or
+ * creating a vector) on every call. To check this, we replace the
+ * global operators new and delete by versions that count the number
+ * of heap allocations. After a warm-up round, in which the quadrature
+ * tables are built and the arena grows to its final size, repeating
+ * the same integrations must not allocate anything; this includes
+ * standard containers on the arena by ArenaAllocator and ArenaResource.
+ * The program returns a nonzero exit code otherwise.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header files for standard utility library and containers
+#include <cstdlib>
+#include <vector>
+
+// Include header file for the bad_alloc exception
+#include <new>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for quadrature rules and the arena
+#include "Arena.hpp"
+#include "ClenshawCurtisRule.hpp"
+#include "CompositeRule.hpp"
+#include "FilonRule.hpp"
+#include "GaussRule.hpp"
+#include "RombergRule.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// Number of heap allocations since program start
+static unsigned long allocations = 0;
+
+// Replacements of the global operators new and delete; the array
+// versions call these by default
+void* operator new(size_t size){
+  allocations++;
+  void* p = malloc(size > 0 ? size : 1);
+  if (p == nullptr)
+    throw bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of panels and number of repetitions from command line
+  // arguments
+  IndexType panels=64, repeat=100;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    panels = atoi(argv[1]);
+    break;
+  case 3:
+    panels = atoi(argv[1]);
+    repeat = atoi(argv[2]);
+    break;
+  default:
+    cout << "Usage: quadrature-arena" << endl;
+    cout << "       quadrature-arena panels" << endl;
+    cout << "       quadrature-arena panels repeat" << endl;
+    exit(-1);
+  }
+
+  cout.precision(15);
+
+  // Quadrature rules are constructed once
+  GaussRule<DataType,IndexType> GR(5);
+  CompositeRule<GaussRule<DataType,IndexType>,DataType,IndexType> CR(GR);
+  RombergRule<DataType,IndexType> RR(1e-10);
+  ClenshawCurtisRule<DataType,IndexType> CC(2);
+  FilonRule<DataType,IndexType> FR(20, 50.0, FilonKind::Cosine);
+
+  // Intervals for the batch integration
+  const IndexType m = 100;
+  DataType a[m], b[m], result[m];
+  for (IndexType i=0; i<m; i++){
+    a[i] = 0.0;
+    b[i] = 0.01*(i+1);
+  }
+
+  // One round of integrations with all entry points; the sum of all
+  // results is returned so that nothing is optimized away
+  auto round = [&](){
+    DataType sum = 0.0;
+    sum += CR.eval([](DataType x){ return exp(cos(x)); }, 0.0, 2.0*M_PI, panels);
+    CR.eval_batch([](DataType x){ return exp(x); }, a, b, result, m);
+    for (IndexType i=0; i<m; i++)
+      sum += result[i];
+    sum += CR.eval_adaptive([](DataType x){ return sqrt(x); }, 0.0, 1.0, 1e-10);
+    sum += RR.eval([](DataType x){ return exp(x); }, 0.0, 1.0);
+    sum += CC.eval_nested([](DataType x){ return exp(cos(x)); }, 0.0, 2.0*M_PI, 1e-13);
+    sum += FR.eval([](DataType x){ return exp(x); }, 0.0, 1.0);
+
+    // Standard containers on the arena of this thread, which grow by
+    // repeated reallocation; all memory is released by the scope
+    {
+      ArenaScope scope;
+      vector<DataType, ArenaAllocator<DataType> > x;
+      for (IndexType i=0; i<m; i++)
+        x.push_back(b[i]);
+#ifdef ARENA_HAS_PMR
+      ArenaResource resource;
+      pmr::vector<DataType> fx(&resource);
+      for (auto xi : x)
+        fx.push_back(exp(xi));
+      for (auto v : fx)
+        sum += v;
+#endif
+    }
+    return sum;
+  };
+
+  // Warm-up: build the quadrature tables and grow the arena
+  DataType sum = round();
+  cout << "Composite Gauss (" << panels << " panels): "
+       << CR.eval([](DataType x){ return exp(cos(x)); }, 0.0, 2.0*M_PI, panels) << endl;
+  DataType IntA = CR.eval_adaptive([](DataType x){ return sqrt(x); }, 0.0, 1.0, 1e-10);
+  cout << "Adaptive Gauss of sqrt(x) on [0,1]: " << IntA << " (" << CR.intervals()
+       << " intervals, " << CR.evaluations() << " evaluations, error "
+       << abs(IntA-2.0/3.0) << ")" << endl;
+  cout << "Arena: " << Arena::local().num_chunks() << " chunk(s), "
+       << Arena::local().capacity() << " bytes" << endl;
+
+  // Steady state: count the heap allocations of repeated rounds
+  unsigned long before = allocations;
+  for (IndexType r=0; r<repeat; r++)
+    sum += round();
+  unsigned long steady = allocations - before;
+
+  cout << "Heap allocations in " << repeat << " steady-state rounds: " << steady
+       << " (checksum " << sum << ")" << endl;
+
+  // End program; fail if the steady state allocated memory
+  return steady == 0 ? 0 : 1;
+}
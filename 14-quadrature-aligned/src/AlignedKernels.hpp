@@ -0,0 +1,97 @@
+/**
+ * \file AlignedKernels.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements integration kernels on padded, 64-byte aligned
+ * quadrature tables in two layouts
+ *
+ * \verbatim
+ * structure of arrays (SoA):  x_0,x_1,...,x_{NP-1} and w_0,...,w_{NP-1}
+ * array of structures (AoS):  x_0,w_0,x_1,w_1,...,x_{NP-1},w_{NP-1}
+ * \endverbatim
+ *
+ * The number of padded points NP is a multiple of the block length L,
+ * which is a compile-time constant. Every block is processed by an
+ * inner loop of fixed length that the compiler can map onto full SIMD
+ * registers without a remainder loop.
+ *
+ * Note that the integrand is also evaluated at the padding points,
+ * which are mapped to the centre of the interval, and multiplied by a
+ * zero weight. The integrand must therefore be finite at the centre.
+ *
+ */
+
+#ifndef ALIGNED_KERNELS_HPP
+#define ALIGNED_KERNELS_HPP
+
+// Include header file for aligned and padded arrays
+#include "AlignedArray.hpp"
+
+using namespace std;
+
+// Tell the compiler that p is aligned to 64 bytes
+template<typename T>
+inline const T* assume_aligned64(const T* p){
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<const T*>(__builtin_assume_aligned(p, 64));
+#else
+  return p;
+#endif
+}
+
+// Reference kernel: plain loop over the N points of an unpadded table
+template<typename TData, typename TIndex, typename TFunc>
+TData eval_scalar(TFunc f, const TData* x, const TData* w, TIndex N, TData a, TData b){
+  const TData h = (b-a)/TData(2);
+  const TData c = (a+b)/TData(2);
+  TData Int = TData(0);
+  for (TIndex k=0; k<N; k++)
+    Int += w[k]*f(h * x[k] + c);
+  return Int * h;
+}
+
+// Kernel for the SoA layout with NP padded points
+template<typename TData, typename TIndex, typename TFunc>
+TData eval_soa(TFunc f, const TData* x, const TData* w, TIndex NP, TData a, TData b){
+  const TIndex L = TIndex(AlignedArray<TData>::lanes);
+  const TData h = (b-a)/TData(2);
+  const TData c = (a+b)/TData(2);
+  x = assume_aligned64(x);
+  w = assume_aligned64(w);
+
+  // One partial sum per lane avoids a serial dependency between the
+  // additions and is reduced once at the end
+  TData sum[AlignedArray<TData>::lanes] = {};
+  for (TIndex k=0; k<NP; k+=L)
+    for (TIndex j=0; j<L; j++)
+      sum[j] += w[k+j]*f(h * x[k+j] + c);
+
+  TData Int = TData(0);
+  for (TIndex j=0; j<L; j++)
+    Int += sum[j];
+  return Int * h;
+}
+
+// Kernel for the interleaved AoS layout with NP padded points
+template<typename TData, typename TIndex, typename TFunc>
+TData eval_aos(TFunc f, const TData* xw, TIndex NP, TData a, TData b){
+  const TIndex L = TIndex(AlignedArray<TData>::lanes);
+  const TData h = (b-a)/TData(2);
+  const TData c = (a+b)/TData(2);
+  xw = assume_aligned64(xw);
+
+  TData sum[AlignedArray<TData>::lanes] = {};
+  for (TIndex k=0; k<NP; k+=L)
+    for (TIndex j=0; j<L; j++)
+      sum[j] += xw[2*(k+j)+1]*f(h * xw[2*(k+j)] + c);
+
+  TData Int = TData(0);
+  for (TIndex j=0; j<L; j++)
+    Int += sum[j];
+  return Int * h;
+}
+
+#endif // ALIGNED_KERNELS_HPP
@@ -0,0 +1,141 @@
+/**
+ * \file Benchmark.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements a small benchmark harness. The callable is
+ * first run repeatedly until a single sample takes at least mintime
+ * seconds, then the given number of samples is taken and the minimum,
+ * median and mean time per call are reported. The minimum is the best
+ * estimate of the cost without interference by other processes; a
+ * large gap between minimum and median indicates a noisy machine.
+ *
+ * If hardware performance counters are available (see PerfCounters),
+ * one more sample is taken with the counters running, and print
+ * reports the counts per item (e.g., per point or panel) next to the
+ * timings; otherwise a note why they are missing is written once at the
+ * end of the program, so that it does not split the tables of timings.
+ *
+ */
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+// Include header files for algorithms, clocks and the vector container
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// Include header files for standard input/output stream library and
+// strings
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Include header file for the hardware performance counters
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+// Prevent the compiler from optimizing away the computation of value
+template<typename T>
+inline void do_not_optimize(const T& value){
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  volatile const T* sink = &value;
+  (void)sink;
+#endif
+}
+
+// Time per call in seconds and, if counted, the hardware counters per
+// call
+struct BenchmarkResult{
+  double min, median, mean;
+  long   calls;
+  bool   counted;
+  double counters[PerfCounters::count];
+};
+
+// Measure the time per call of f()
+template<typename TFunc>
+BenchmarkResult benchmark(TFunc f, int samples=11, double mintime=1e-2){
+  typedef chrono::steady_clock clock;
+
+  // Calibrate the number of calls per sample
+  long calls = 1;
+  for (;;){
+    auto start = clock::now();
+    for (long i=0; i<calls; i++)
+      f();
+    double t = chrono::duration<double>(clock::now()-start).count();
+    if (t >= mintime || calls >= (1L << 40))
+      break;
+    calls *= 2;
+  }
+
+  // Take the samples
+  vector<double> times(samples);
+  for (int s=0; s<samples; s++){
+    auto start = clock::now();
+    for (long i=0; i<calls; i++)
+      f();
+    times[s] = chrono::duration<double>(clock::now()-start).count()/double(calls);
+  }
+
+  sort(times.begin(), times.end());
+  BenchmarkResult r;
+  r.min    = times.front();
+  r.median = times[samples/2];
+  r.mean   = 0.0;
+  for (double t : times)
+    r.mean += t/double(samples);
+  r.calls  = calls;
+
+  // One more sample with the hardware counters running
+  PerfCounters& pc = perf_counters();
+  r.counted = pc.available();
+  for (int i=0; i<PerfCounters::count; i++)
+    r.counters[i] = 0.0;
+  if (r.counted){
+    pc.start();
+    for (long i=0; i<calls; i++)
+      f();
+    pc.stop();
+    for (int i=0; i<PerfCounters::count; i++)
+      r.counters[i] = pc.value(i)/double(calls);
+  }
+  return r;
+}
+
+// Print the result in nanoseconds per call, optionally divided by the
+// number of items (e.g., points or panels) processed per call
+inline void print(const string& name, const BenchmarkResult& r, double items=1.0){
+  cout << left << setw(32) << name << right << fixed << setprecision(3)
+       << setw(12) << 1e9*r.min/items << " ns (min) "
+       << setw(12) << 1e9*r.median/items << " ns (median)" << endl;
+
+  const PerfCounters& pc = perf_counters();
+  if (r.counted){
+    cout << setw(32) << "" << setprecision(2);
+    for (int i=0; i<PerfCounters::count; i++)
+      if (pc.available(i))
+        cout << " " << r.counters[i]/items << " " << PerfCounters::name(i);
+    if (pc.available(0) && pc.available(1) && r.counters[0] > 0.0)
+      cout << " (" << r.counters[1]/r.counters[0] << " IPC)";
+    cout << endl;
+  }
+  else{
+    // The note is written by the destructor of a static object, i.e.,
+    // when the program ends
+    static struct Note{
+      string text;
+      ~Note(){ cout << text << endl; }
+    } note{"(no hardware counters: " + pc.error() + ")"};
+  }
+  cout.unsetf(ios::floatfield);
+}
+
+#endif // BENCHMARK_HPP
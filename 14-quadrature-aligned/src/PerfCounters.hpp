@@ -0,0 +1,171 @@
+/**
+ * \file PerfCounters.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements an optional collector of hardware performance
+ * counters (cycles, instructions, branch misses, L1 data cache and
+ * last level cache misses) for the benchmark harness, based on the
+ * Linux system call perf_event_open. Each counter is opened separately
+ * for the calling thread (user space only), so that a counter that is
+ * not supported by the CPU does not disable the others. If the kernel
+ * multiplexes the counters, the values are scaled by the fraction of
+ * time a counter was actually running.
+ *
+ * The counters are not available on other systems, in most virtual
+ * machines and containers, or if /proc/sys/kernel/perf_event_paranoid
+ * forbids their use; then available() is false, the reason is given by
+ * error(), and the benchmarks only report timings. Set the environment
+ * variable QUAD_COUNTERS=0 to switch the counters off.
+ *
+ */
+
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+// Include header files for C strings and the error number
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+// Include header file for strings
+#include <string>
+
+#if defined(__linux__)
+// Include header files for the perf_event_open system call
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define HAVE_PERF_EVENTS
+#endif
+
+using namespace std;
+
+class PerfCounters{
+
+public:
+  // Number of counters
+  static constexpr int count = 5;
+
+private:
+  // File descriptors of the counters (-1 if not available), the
+  // values of the last measurement and the reason if none is available
+  int    fd[count];
+  double val[count];
+  string err;
+
+public:
+  // Name of counter i
+  static const char* name(int i){
+    static const char* names[count] = {"cycles", "instructions", "branch misses",
+                                       "L1d misses", "LLC misses"};
+    return names[i];
+  }
+
+  // Constructor: open the counters for the calling thread
+  PerfCounters() : err("not supported on this system"){
+    for (int i=0; i<count; i++){
+      fd[i]  = -1;
+      val[i] = 0.0;
+    }
+
+#ifdef HAVE_PERF_EVENTS
+    if (const char* env = getenv("QUAD_COUNTERS"))
+      if (strcmp(env, "0") == 0){
+        err = "switched off by QUAD_COUNTERS=0";
+        return;
+      }
+
+    const unsigned long long cache_miss =
+      (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const unsigned int type[count] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                      PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+                                      PERF_TYPE_HW_CACHE};
+    const unsigned long long config[count] = {PERF_COUNT_HW_CPU_CYCLES,
+                                              PERF_COUNT_HW_INSTRUCTIONS,
+                                              PERF_COUNT_HW_BRANCH_MISSES,
+                                              PERF_COUNT_HW_CACHE_L1D | cache_miss,
+                                              PERF_COUNT_HW_CACHE_LL | cache_miss};
+
+    for (int i=0; i<count; i++){
+      perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size           = sizeof(attr);
+      attr.type           = type[i];
+      attr.config         = config[i];
+      attr.disabled       = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      fd[i] = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      if (fd[i] < 0)
+        err = string("perf_event_open: ") + strerror(errno);
+    }
+    if (available())
+      err.clear();
+#endif
+  }
+
+  // Close the counters; the object cannot be copied
+  ~PerfCounters(){
+#ifdef HAVE_PERF_EVENTS
+    for (int i=0; i<count; i++)
+      if (fd[i] >= 0)
+        close(fd[i]);
+#endif
+  }
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  // Whether at least one counter is available, whether counter i is
+  // available, and why no counter is available
+  bool available() const {
+    for (int i=0; i<count; i++)
+      if (fd[i] >= 0)
+        return true;
+    return false;
+  }
+  bool available(int i) const { return fd[i] >= 0; }
+  const string& error() const { return err; }
+
+  // Reset and start the counters
+  void start(){
+#ifdef HAVE_PERF_EVENTS
+    for (int i=0; i<count; i++)
+      if (fd[i] >= 0){
+        ioctl(fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd[i], PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+  }
+
+  // Stop the counters and read their values
+  void stop(){
+#ifdef HAVE_PERF_EVENTS
+    for (int i=0; i<count; i++)
+      if (fd[i] >= 0)
+        ioctl(fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    for (int i=0; i<count; i++){
+      // value, time enabled, time running
+      unsigned long long data[3] = {0, 0, 0};
+      val[i] = 0.0;
+      if (fd[i] >= 0 && read(fd[i], data, sizeof(data)) == ssize_t(sizeof(data)) && data[2] > 0)
+        val[i] = double(data[0])*double(data[1])/double(data[2]);
+    }
+#endif
+  }
+
+  // Value of counter i of the last measurement
+  double value(int i) const { return val[i]; }
+};
+
+// The counters of the main thread, shared by all benchmarks
+inline PerfCounters& perf_counters(){
+  static PerfCounters counters;
+  return counters;
+}
+
+#endif // PERF_COUNTERS_HPP
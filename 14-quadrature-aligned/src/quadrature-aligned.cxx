@@ -0,0 +1,111 @@
+/**
+ * \file quadrature-aligned.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we store the quadrature points and weights in
+ * 64-byte aligned arrays that are padded with zero weights to a
+ * multiple of the SIMD width. We compare the plain loop over the n
+ * points with the padded kernels for separate arrays of points and
+ * weights (SoA) and for interleaved pairs (AoS) by integrating
+ * 1/(1+x^2) over [0,1] with a composite rule.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header file for standard utility library
+#include <cstdlib>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for quadrature rules, kernels and the
+// benchmark harness
+#include "AlignedKernels.hpp"
+#include "Benchmark.hpp"
+#include "GaussJacobiRule.hpp"
+#include "GaussRule.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of panels from command line arguments
+  IndexType panels=1000;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    panels = atoi(argv[1]);
+    break;
+  default:
+    cout << "Usage: quadrature-aligned" << endl;
+    cout << "       quadrature-aligned panels" << endl;
+    exit(-1);
+  }
+
+  cout.precision(15);
+
+  // Integrand without calls to the math library so that the compiler
+  // is free to vectorize the kernels
+  auto f = [](DataType x){ return 1.0/(1.0+x*x); };
+  const DataType exact = M_PI/4.0, H = 1.0/panels;
+
+  // The padded tables of GaussRule give the same result as the plain
+  // loop since the extra weights are zero
+  GaussRule<DataType,IndexType> GR(7);
+  cout << "GaussRule n=7 padded to " << GR.padded_size() << " points: error "
+       << abs(eval_soa(f, GR.points(), GR.weights(), GR.padded_size(), 0.0, 1.0)
+              - eval_scalar(f, GR.points(), GR.weights(), GR.size(), 0.0, 1.0)) << endl;
+
+  cout << "Composite Gauss-Legendre rules on " << panels << " panels, time per panel:" << endl;
+  for (IndexType n : {3, 5, 7, 8, 9, 15, 20}){
+    GaussJacobiRule<DataType,IndexType> GJ(n);
+    const DataType *x = GJ.points(), *w = GJ.weights(), *xw = GJ.interleaved();
+    const IndexType N = GJ.size(), NP = GJ.padded_size();
+
+    DataType Is = 0.0, Ia = 0.0, Ib = 0.0;
+    auto scalar = [&](){
+      Is = 0.0;
+      for (IndexType p=0; p<panels; p++)
+        Is += eval_scalar(f, x, w, N, p*H, (p+1)*H);
+      do_not_optimize(Is);
+    };
+    auto soa = [&](){
+      Ia = 0.0;
+      for (IndexType p=0; p<panels; p++)
+        Ia += eval_soa(f, x, w, NP, p*H, (p+1)*H);
+      do_not_optimize(Ia);
+    };
+    auto aos = [&](){
+      Ib = 0.0;
+      for (IndexType p=0; p<panels; p++)
+        Ib += eval_aos(f, xw, NP, p*H, (p+1)*H);
+      do_not_optimize(Ib);
+    };
+
+    BenchmarkResult rs = benchmark(scalar), ra = benchmark(soa), rb = benchmark(aos);
+    cout << "n=" << n << " (padded to " << NP << "), errors " << abs(Is-exact) << ", "
+         << abs(Ia-exact) << ", " << abs(Ib-exact) << endl;
+    print("  plain loop over n points", rs, panels);
+    print("  padded SoA (x[], w[])", ra, panels);
+    print("  padded AoS (x,w pairs)", rb, panels);
+    cout.precision(15);
+  }
+
+  // End program
+  return 0;
+}
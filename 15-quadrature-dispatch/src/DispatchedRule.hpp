@@ -0,0 +1,114 @@
+/**
+ * \file DispatchedRule.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements composite Gauss and Simpson integration on top
+ * of the kernels from Kernels.hpp, which are selected at run time for
+ * the instruction set of the CPU.
+ *
+ * Integration is split into three passes: mapping the points to the
+ * panels (kernel), evaluating the integrand at all points (user code)
+ * and summing up the weighted values (kernel). The integrand itself is
+ * compiled with the flags of the calling translation unit; it can be,
+ * e.g., a lambda or a function object derived from FunctionBase.
+ *
+ * Since the kernels are compiled for double, so is this class. The
+ * rule must provide padded, 64-byte aligned tables, e.g., GaussRule
+ * from 06-quadrature-oop1-templates or GaussJacobiRule from
+ * 09-quadrature-oscillatory. Scratch memory is taken from the
+ * thread-local arena.
+ *
+ */
+
+#ifndef DISPATCHED_RULE_HPP
+#define DISPATCHED_RULE_HPP
+
+// Include header file for exceptions
+#include <stdexcept>
+
+// Include header files for the scratch memory arena and the kernels
+#include "Arena.hpp"
+#include "Kernels.hpp"
+
+using namespace std;
+
+class DispatchedRule{
+
+private:
+  // Number of points and padded number of points
+  long N, NP;
+
+  // Padded quadrature points and weights on [-1,1] (owned by the rule)
+  const double *x, *w;
+
+public:
+  // Constructor; the rule must outlive this object
+  template<typename TRule>
+  DispatchedRule(const TRule& rule)
+    : N(rule.size()), NP(rule.padded_size()), x(rule.points()), w(rule.weights()){}
+
+  // Name of the selected ISA
+  static const char* isa(){ return kernels().name; }
+
+  // Method that evaluates the integral of f over [a,b] divided into p
+  // panels of equal length. The integrand is also evaluated at the
+  // padding points, i.e. at the panel centres, with zero weight.
+  template<typename TFunc>
+  double eval(TFunc f, double a, double b, long p=1) const {
+    if (p < 1)
+      throw invalid_argument("Number of panels must be positive.");
+
+    const KernelTable& K = kernels();
+    const double H = (b-a)/double(p);
+
+    ArenaScope scope;
+    double* X = scope.allocate<double>(p*NP);
+    double* F = scope.allocate<double>(p*NP);
+
+    K.composite_map(x, NP, p, a, H, X);
+    for (long i=0; i<p*NP; i++)
+      F[i] = f(X[i]);
+    return K.composite_sum(w, F, NP, p) * H/2.0;
+  }
+
+  // Method as eval, but the integrand is evaluated for all points at
+  // once by f(const double* X, double* F, long n), e.g., with the
+  // vectorized elementary functions from 16-vector-math
+  template<typename TBlockFunc>
+  double eval_block(TBlockFunc f, double a, double b, long p=1) const {
+    if (p < 1)
+      throw invalid_argument("Number of panels must be positive.");
+
+    const KernelTable& K = kernels();
+    const double H = (b-a)/double(p);
+
+    ArenaScope scope;
+    double* X = scope.allocate<double>(p*NP);
+    double* F = scope.allocate<double>(p*NP);
+
+    K.composite_map(x, NP, p, a, H, X);
+    f(static_cast<const double*>(X), F, p*NP);
+    return K.composite_sum(w, F, NP, p) * H/2.0;
+  }
+
+  // Method that evaluates the integral of f over [a,b] by the
+  // composite Simpson rule with m panels
+  template<typename TFunc>
+  static double simpson(TFunc f, double a, double b, long m){
+    if (m < 1)
+      throw invalid_argument("Number of panels must be positive.");
+
+    const double h = (b-a)/double(2*m);
+
+    ArenaScope scope;
+    double* F = scope.allocate<double>(2*m+1);
+    for (long i=0; i<=2*m; i++)
+      F[i] = f(a + double(i)*h);
+    return kernels().simpson_sum(F, m) * h/3.0;
+  }
+};
+
+#endif // DISPATCHED_RULE_HPP
@@ -0,0 +1,65 @@
+/**
+ * \file Kernels.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * Run-time selection of the kernel table, see Kernels.hpp. This file
+ * is compiled without extra ISA flags so that it can run on every CPU.
+ *
+ */
+
+// Include header file for standard utility library
+#include <cstdlib>
+
+// Include header file for the kernel tables
+#include "Kernels.hpp"
+
+using namespace std;
+
+// Check whether the CPU supports the given ISA. GCC and Clang provide
+// __builtin_cpu_supports, which queries cpuid (and whether the
+// operating system saves the wide registers) once at program start.
+bool cpu_supports(const string& isa){
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  if (isa == "avx2")
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  if (isa == "avx512")
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq");
+#endif
+  return isa == "generic";
+}
+
+vector<KernelTable> available_kernels(){
+  vector<KernelTable> tables;
+  tables.push_back(kernel_table_generic());
+#ifdef HAVE_AVX2_KERNELS
+  if (cpu_supports("avx2"))
+    tables.push_back(kernel_table_avx2());
+#endif
+#ifdef HAVE_AVX512_KERNELS
+  if (cpu_supports("avx512"))
+    tables.push_back(kernel_table_avx512());
+#endif
+  return tables;
+}
+
+// Select the widest available ISA or the one requested by QUAD_ISA.
+// An unknown or unsupported request falls back to the automatic
+// choice, so that a wrong setting never leads to an illegal
+// instruction.
+static KernelTable select_kernels(){
+  vector<KernelTable> tables = available_kernels();
+  if (const char* isa = getenv("QUAD_ISA"))
+    for (auto& t : tables)
+      if (string(t.name) == isa)
+        return t;
+  return tables.back();
+}
+
+const KernelTable& kernels(){
+  // Initialization of function-local statics is thread-safe in C++11
+  static const KernelTable table = select_kernels();
+  return table;
+}
@@ -0,0 +1,73 @@
+/**
+ * \file Kernels.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file declares the integration kernels that are compiled several
+ * times for different instruction set architectures (ISAs) and the
+ * run-time selection of the best version supported by the CPU.
+ *
+ * The same source code (KernelsImpl.hpp) is compiled once without
+ * extra flags (generic, i.e. SSE2 on x86-64) and, if the compiler
+ * supports it, once with AVX2/FMA and once with AVX-512. Every
+ * translation unit exports a table of function pointers. The function
+ * kernels() inspects the CPU once (via cpuid) and returns the table of
+ * the widest ISA that is both compiled in and supported, so that a
+ * single binary runs everywhere and uses AVX-512 where it exists.
+ *
+ * The environment variable QUAD_ISA=generic|avx2|avx512 overrides the
+ * automatic choice, e.g., for testing and benchmarking.
+ *
+ */
+
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+// Include header files for strings and the vector container
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Table of kernels compiled for one ISA. All arrays are 64-byte
+// aligned; n is the padded number of points of the rule, i.e. a
+// multiple of 8.
+struct KernelTable{
+  // Name of the ISA
+  const char* name;
+
+  // Map the n points x to the p panels [a+i*H,a+(i+1)*H] and store
+  // them consecutively in X
+  void (*composite_map)(const double* x, long n, long p, double a, double H, double* X);
+
+  // Sum of the weighted function values over the p panels, i.e.
+  // sum_i sum_k w[k]*F[i*n+k]
+  double (*composite_sum)(const double* w, const double* F, long n, long p);
+
+  // Composite Simpson sum F[0] + 4F[1] + 2F[2] + ... + 4F[2m-1] + F[2m]
+  // of the 2m+1 function values F
+  double (*simpson_sum)(const double* F, long m);
+};
+
+// Kernel tables of the individual translation units
+KernelTable kernel_table_generic();
+#ifdef HAVE_AVX2_KERNELS
+KernelTable kernel_table_avx2();
+#endif
+#ifdef HAVE_AVX512_KERNELS
+KernelTable kernel_table_avx512();
+#endif
+
+// Check whether the CPU supports the ISA generic, avx2 or avx512
+bool cpu_supports(const string& isa);
+
+// All kernel tables that are compiled in and supported by the CPU,
+// ordered from the narrowest to the widest ISA
+vector<KernelTable> available_kernels();
+
+// Kernel table selected at the first call
+const KernelTable& kernels();
+
+#endif // KERNELS_HPP
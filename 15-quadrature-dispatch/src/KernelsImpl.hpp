@@ -0,0 +1,98 @@
+/**
+ * \file KernelsImpl.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the integration kernels declared in Kernels.hpp.
+ * It is included by every kernels-<isa>.cxx, which are compiled with
+ * different ISA flags. Everything is in an anonymous namespace, so
+ * that each translation unit gets its own copy; otherwise the linker
+ * would be free to pick, e.g., the AVX-512 instantiation of a shared
+ * inline function for the generic code path. For the same reason the
+ * kernels only use plain arithmetic and no inline functions from
+ * other headers.
+ *
+ * The loops work on blocks of B=8 doubles with one partial sum per
+ * lane. This fixes the order of the additions independently of the
+ * ISA, so the versions only differ by the rounding of fused
+ * multiply-adds, and it allows the compiler to vectorize the
+ * reductions without -ffast-math.
+ *
+ */
+
+#ifndef KERNELS_IMPL_HPP
+#define KERNELS_IMPL_HPP
+
+// Include header file for the kernel table
+#include "Kernels.hpp"
+
+// Tell the compiler that the pointer p is 64-byte aligned
+#if defined(__GNUC__) || defined(__clang__)
+#define ASSUME_ALIGNED64(p) __builtin_assume_aligned(p, 64)
+#else
+#define ASSUME_ALIGNED64(p) (p)
+#endif
+
+namespace {
+
+// Block length
+const long B = 8;
+
+void composite_map(const double* x, long n, long p, double a, double H, double* X){
+  x = static_cast<const double*>(ASSUME_ALIGNED64(x));
+  const double h = H/2.0;
+  for (long i=0; i<p; i++){
+    const double c = a + (double(i)+0.5)*H;
+    double* Xi = X + i*n;
+    for (long k=0; k<n; k++)
+      Xi[k] = h * x[k] + c;
+  }
+}
+
+double composite_sum(const double* w, const double* F, long n, long p){
+  w = static_cast<const double*>(ASSUME_ALIGNED64(w));
+  double s[B] = {};
+  for (long i=0; i<p; i++){
+    const double* Fi = F + i*n;
+    for (long k=0; k<n; k+=B)
+      for (long j=0; j<B; j++)
+        s[j] += w[k+j]*Fi[k+j];
+  }
+  double sum = 0.0;
+  for (long j=0; j<B; j++)
+    sum += s[j];
+  return sum;
+}
+
+double simpson_sum(const double* F, long m){
+  // Within a block that starts at an odd index the coefficients
+  // alternate between 4 and 2
+  const double coef[B] = {4.0, 2.0, 4.0, 2.0, 4.0, 2.0, 4.0, 2.0};
+  double s[B] = {};
+  long i = 1;
+  for (; i+B <= 2*m; i+=B)
+    for (long j=0; j<B; j++)
+      s[j] += coef[j]*F[i+j];
+
+  double sum = F[0] + F[2*m];
+  for (long j=0; j<B; j++)
+    sum += s[j];
+  for (; i<2*m; i++)
+    sum += (i % 2 == 1 ? 4.0 : 2.0)*F[i];
+  return sum;
+}
+
+KernelTable make_kernel_table(const char* name){
+  KernelTable t;
+  t.name          = name;
+  t.composite_map = composite_map;
+  t.composite_sum = composite_sum;
+  t.simpson_sum   = simpson_sum;
+  return t;
+}
+
+} // namespace
+
+#endif // KERNELS_IMPL_HPP
@@ -0,0 +1,17 @@
+/**
+ * \file kernels-avx2.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * Integration kernels compiled with -mavx2 -mfma, see Kernels.hpp.
+ *
+ */
+
+// Include header file for the kernel implementation
+#include "KernelsImpl.hpp"
+
+KernelTable kernel_table_avx2(){
+  return make_kernel_table("avx2");
+}
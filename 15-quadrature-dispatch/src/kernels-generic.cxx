@@ -0,0 +1,19 @@
+/**
+ * \file kernels-generic.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * Integration kernels compiled without extra ISA flags, i.e. for the
+ * baseline of the target architecture (SSE2 on x86-64), see
+ * Kernels.hpp.
+ *
+ */
+
+// Include header file for the kernel implementation
+#include "KernelsImpl.hpp"
+
+KernelTable kernel_table_generic(){
+  return make_kernel_table("generic");
+}
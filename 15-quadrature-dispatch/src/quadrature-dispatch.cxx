@@ -0,0 +1,153 @@
+/**
+ * \file quadrature-dispatch.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version the integration kernels are compiled several times
+ * for different instruction sets (generic/SSE2, AVX2 and AVX-512) and
+ * the best version supported by the CPU is selected at run time. The
+ * same binary therefore runs on every x86-64 machine. Set the
+ * environment variable QUAD_ISA=generic|avx2|avx512 to override the
+ * choice; the benchmark at the end compares all available versions.
+ * Before, GaussRule::eval is compared with FunctionBase::integrate,
+ * together with hardware counters where available (see PerfCounters).
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header file for standard utility library
+#include <cstdlib>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for quadrature rules, kernels and the
+// benchmark harness
+#include "AlignedArray.hpp"
+#include "Benchmark.hpp"
+#include "DispatchedRule.hpp"
+#include "FunctionBase.hpp"
+#include "GaussRule.hpp"
+
+using namespace std;
+
+// Function object as in 07-quadrature-oop2-templates
+class Function1 : public FunctionBase<double>{
+public:
+  double operator()(double x){
+    return cos(x);
+  }
+};
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of panels from command line arguments
+  long panels=10000;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    panels = atol(argv[1]);
+    break;
+  default:
+    cout << "Usage: quadrature-dispatch" << endl;
+    cout << "       quadrature-dispatch panels" << endl;
+    exit(-1);
+  }
+
+  cout.precision(15);
+
+  cout << "Kernels compiled in and supported by this CPU:";
+  for (auto& t : available_kernels())
+    cout << " " << t.name;
+  cout << endl << "Selected kernels: " << DispatchedRule::isa() << endl;
+
+  // Composite Gauss and Simpson rules with the selected kernels
+  GaussRule<DataType,IndexType> GR(7);
+  DispatchedRule DR(GR);
+  Function1 F1;
+  const DataType a = 0.0, b = 2.0*M_PI;
+
+  // int_0^2pi exp(cos(x)) dx = 2*pi*I_0(1), modified Bessel function
+  const DataType exact = 2.0*M_PI*1.266065877752008335598244625;
+  DataType IntG = DR.eval([](DataType x){ return exp(cos(x)); }, a, b, 16);
+  DataType IntS = DispatchedRule::simpson([](DataType x){ return exp(cos(x)); }, a, b, 64);
+  DataType IntF = DR.eval([&F1](DataType x){ return F1(x); }, 0.0, M_PI_2, 1);
+  cout << "Composite 7-pt Gauss, exp(cos(x)) on 16 panels: " << IntG
+       << " (error " << abs(IntG-exact) << ")" << endl;
+  cout << "Composite Simpson, exp(cos(x)) on 64 panels:    " << IntS
+       << " (error " << abs(IntS-exact) << ")" << endl;
+  cout << "7-pt Gauss, FunctionBase cos(x) on [0,pi/2]:    " << IntF
+       << " (error " << abs(IntF-1.0) << ")" << endl;
+
+  // Compare GaussRule::eval with an inlined integrand, GaussRule::eval
+  // with a virtual call per point and FunctionBase::integrate on the
+  // same composite rule; with hardware counters, the cycles,
+  // instructions and misses per point show where the time goes
+  const DataType Hc = (b-a)/panels;
+  FunctionBase<DataType>& FB = F1;
+  DataType Ic = 0.0;
+  cout << "Composite 7-pt Gauss, cos(x) on " << panels << " panels, time per point:" << endl;
+  print("  GaussRule::eval, inlined", benchmark([&](){
+        Ic = 0.0;
+        for (long i=0; i<panels; i++)
+          Ic += GR.eval([](DataType x){ return cos(x); }, a + i*Hc, a + (i+1)*Hc);
+        do_not_optimize(Ic);
+      }), 7.0*panels);
+  print("  GaussRule::eval, virtual call", benchmark([&](){
+        Ic = 0.0;
+        for (long i=0; i<panels; i++)
+          Ic += GR.eval([&FB](DataType x){ return FB(x); }, a + i*Hc, a + (i+1)*Hc);
+        do_not_optimize(Ic);
+      }), 7.0*panels);
+  print("  FunctionBase::integrate", benchmark([&](){
+        Ic = 0.0;
+        for (long i=0; i<panels; i++)
+          Ic += FB.integrate(a + i*Hc, a + (i+1)*Hc, 7);
+        do_not_optimize(Ic);
+      }), 7.0*panels);
+
+  // Benchmark the kernels of all available ISAs on the same data. The
+  // function values are computed once, so that only the kernels are
+  // timed.
+  const long NP = GR.padded_size();
+  const DataType H = (b-a)/panels;
+  AlignedArray<DataType> X(panels*NP), F(panels*NP), S(2*panels+1);
+  for (long i=0; i<panels*NP; i++)
+    F[i] = 1.0/(1.0+i%7);
+  for (long i=0; i<=2*panels; i++)
+    S[i] = 1.0/(1.0+i%5);
+
+  cout << "Kernel benchmark with " << panels << " panels, time per panel:" << endl;
+  for (auto& K : available_kernels()){
+    DataType sum = 0.0;
+    BenchmarkResult rg = benchmark([&](){
+        K.composite_map(GR.points(), NP, panels, a, H, X.data());
+        sum = K.composite_sum(GR.weights(), F.data(), NP, panels);
+        do_not_optimize(X[0]);
+        do_not_optimize(sum);
+      });
+    BenchmarkResult rs = benchmark([&](){
+        sum = K.simpson_sum(S.data(), panels);
+        do_not_optimize(sum);
+      });
+    print(string("  ") + K.name + " Gauss map+sum", rg, panels);
+    print(string("  ") + K.name + " Simpson sum", rs, panels);
+  }
+
+  // End program
+  return 0;
+}
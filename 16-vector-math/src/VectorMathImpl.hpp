@@ -0,0 +1,74 @@
+/**
+ * \file VectorMathImpl.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the batch functions declared in
+ * VectorMathKernels.hpp. It is included by every vector-math-<isa>.cxx;
+ * as in 15-quadrature-dispatch, everything has internal linkage so
+ * that each translation unit keeps the code for its own ISA.
+ *
+ */
+
+#ifndef VECTOR_MATH_IMPL_HPP
+#define VECTOR_MATH_IMPL_HPP
+
+// Include header files for the elementary functions and the table
+#include "VectorMath.hpp"
+#include "VectorMathKernels.hpp"
+
+namespace {
+
+// y[i] = f(x[i]); the loops are vectorized by the compiler
+template<typename T>
+void exp_n(const T* x, T* y, long n){
+  for (long i=0; i<n; i++)
+    y[i] = vexp(x[i]);
+}
+
+template<typename T>
+void log_n(const T* x, T* y, long n){
+  for (long i=0; i<n; i++)
+    y[i] = vlog(x[i]);
+}
+
+template<typename T>
+void sin_n(const T* x, T* y, long n){
+  for (long i=0; i<n; i++)
+    y[i] = vsin(x[i]);
+}
+
+template<typename T>
+void cos_n(const T* x, T* y, long n){
+  for (long i=0; i<n; i++)
+    y[i] = vcos(x[i]);
+}
+
+template<typename T>
+void sqrt_n(const T* x, T* y, long n){
+  for (long i=0; i<n; i++)
+    y[i] = vsqrt(x[i]);
+}
+
+
+VectorMathTable make_vector_math_table(const char* name){
+  VectorMathTable t;
+  t.name   = name;
+  t.exp_d  = exp_n<double>;
+  t.log_d  = log_n<double>;
+  t.sin_d  = sin_n<double>;
+  t.cos_d  = cos_n<double>;
+  t.sqrt_d = sqrt_n<double>;
+  t.exp_f  = exp_n<float>;
+  t.log_f  = log_n<float>;
+  t.sin_f  = sin_n<float>;
+  t.cos_f  = cos_n<float>;
+  t.sqrt_f = sqrt_n<float>;
+  return t;
+}
+
+} // namespace
+
+#endif // VECTOR_MATH_IMPL_HPP
@@ -0,0 +1,53 @@
+/**
+ * \file VectorMathKernels.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * Run-time selection of the batch elementary functions, see
+ * VectorMathKernels.hpp. The CPU is queried by cpu_supports from
+ * 15-quadrature-dispatch.
+ *
+ */
+
+// Include header file for standard utility library
+#include <cstdlib>
+
+// Include header file for strings
+#include <string>
+
+// Include header files for the tables and the CPU detection
+#include "Kernels.hpp"
+#include "VectorMathKernels.hpp"
+
+using namespace std;
+
+vector<VectorMathTable> available_vector_math(){
+  vector<VectorMathTable> tables;
+  tables.push_back(vector_math_table_generic());
+#ifdef HAVE_AVX2_KERNELS
+  if (cpu_supports("avx2"))
+    tables.push_back(vector_math_table_avx2());
+#endif
+#ifdef HAVE_AVX512_KERNELS
+  if (cpu_supports("avx512"))
+    tables.push_back(vector_math_table_avx512());
+#endif
+  return tables;
+}
+
+// Select the widest available ISA or the one requested by QUAD_ISA
+static VectorMathTable select_vector_math(){
+  vector<VectorMathTable> tables = available_vector_math();
+  if (const char* isa = getenv("QUAD_ISA"))
+    for (auto& t : tables)
+      if (string(t.name) == isa)
+        return t;
+  return tables.back();
+}
+
+const VectorMathTable& vector_math(){
+  static const VectorMathTable table = select_vector_math();
+  return table;
+}
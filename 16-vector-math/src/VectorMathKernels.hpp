@@ -0,0 +1,60 @@
+/**
+ * \file VectorMathKernels.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file declares batch versions y[i] = f(x[i]), i=0,...,n-1, of
+ * the functions from VectorMath.hpp. As the integration kernels in
+ * 15-quadrature-dispatch, they are compiled once per instruction set
+ * and selected at run time; QUAD_ISA=generic|avx2|avx512 overrides the
+ * choice. The arrays x and y may coincide.
+ *
+ */
+
+#ifndef VECTOR_MATH_KERNELS_HPP
+#define VECTOR_MATH_KERNELS_HPP
+
+// Include header file for the vector container
+#include <vector>
+
+using namespace std;
+
+// Table of batch functions compiled for one ISA
+struct VectorMathTable{
+  // Name of the ISA
+  const char* name;
+
+  // Double precision
+  void (*exp_d)(const double* x, double* y, long n);
+  void (*log_d)(const double* x, double* y, long n);
+  void (*sin_d)(const double* x, double* y, long n);
+  void (*cos_d)(const double* x, double* y, long n);
+  void (*sqrt_d)(const double* x, double* y, long n);
+
+  // Single precision
+  void (*exp_f)(const float* x, float* y, long n);
+  void (*log_f)(const float* x, float* y, long n);
+  void (*sin_f)(const float* x, float* y, long n);
+  void (*cos_f)(const float* x, float* y, long n);
+  void (*sqrt_f)(const float* x, float* y, long n);
+};
+
+// Tables of the individual translation units
+VectorMathTable vector_math_table_generic();
+#ifdef HAVE_AVX2_KERNELS
+VectorMathTable vector_math_table_avx2();
+#endif
+#ifdef HAVE_AVX512_KERNELS
+VectorMathTable vector_math_table_avx512();
+#endif
+
+// All tables that are compiled in and supported by the CPU, ordered
+// from the narrowest to the widest ISA
+vector<VectorMathTable> available_vector_math();
+
+// Table selected at the first call
+const VectorMathTable& vector_math();
+
+#endif // VECTOR_MATH_KERNELS_HPP
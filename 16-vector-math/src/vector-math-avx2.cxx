@@ -0,0 +1,18 @@
+/**
+ * \file vector-math-avx2.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * Batch elementary functions compiled with -mavx2 -mfma, see
+ * VectorMathKernels.hpp.
+ *
+ */
+
+// Include header file for the implementation of the batch functions
+#include "VectorMathImpl.hpp"
+
+VectorMathTable vector_math_table_avx2(){
+  return make_vector_math_table("avx2");
+}
@@ -0,0 +1,18 @@
+/**
+ * \file vector-math-generic.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * Batch elementary functions compiled without extra ISA flags, see
+ * VectorMathKernels.hpp.
+ *
+ */
+
+// Include header file for the implementation of the batch functions
+#include "VectorMathImpl.hpp"
+
+VectorMathTable vector_math_table_generic(){
+  return make_vector_math_table("generic");
+}
@@ -0,0 +1,187 @@
+/**
+ * \file vector-math.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we replace the elementary functions from <cmath> by
+ * branch-free versions that the compiler can vectorize. We measure
+ * their accuracy in units in the last place (ulp) against long double
+ * reference values and their speed for all instruction sets that the
+ * CPU supports. Finally, we use them in integrands: in a Function1
+ * object as in 07-quadrature-oop2-templates and in the block
+ * evaluation path of DispatchedRule from 15-quadrature-dispatch.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header files for standard utility library and random numbers
+#include <cstdlib>
+#include <random>
+
+// Include header file for numeric limits
+#include <limits>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for the vector math library, quadrature rules
+// and the benchmark harness
+#include "AlignedArray.hpp"
+#include "Benchmark.hpp"
+#include "DispatchedRule.hpp"
+#include "FunctionBase.hpp"
+#include "GaussRule.hpp"
+#include "VectorMath.hpp"
+#include "VectorMathKernels.hpp"
+
+using namespace std;
+
+// Function object as in 07-quadrature-oop2-templates, but with the
+// vectorizable cosine
+class Function1 : public FunctionBase<double>{
+public:
+  double operator()(double x){
+    return vcos(x);
+  }
+};
+
+// Error of y in units in the last place of the exact value ref
+template<typename T>
+double ulp_error(T y, long double ref){
+  const T r = T(ref);
+  if (isinf(r) || isnan(r))
+    return (y == r || (isnan(y) && isnan(r))) ? 0.0 : numeric_limits<double>::infinity();
+  const T ulp = nextafter(abs(r), numeric_limits<T>::infinity()) - abs(r);
+  return double(abs((long double)y - ref)/(long double)ulp);
+}
+
+// Maximum error of the batch function f against the reference g for n
+// points drawn from x = sample(random number in [0,1))
+template<typename T, typename TBatch, typename TRef, typename TSample>
+double max_ulp(TBatch f, TRef g, TSample sample, long n){
+  mt19937_64 rng(42);
+  uniform_real_distribution<double> u(0.0, 1.0);
+  AlignedArray<T> x(n), y(n);
+  for (long i=0; i<n; i++)
+    x[i] = T(sample(u(rng)));
+  f(x.data(), y.data(), n);
+
+  double err = 0.0;
+  for (long i=0; i<n; i++)
+    err = max(err, ulp_error(y[i], g((long double)x[i])));
+  return err;
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of test points from command line arguments
+  long n=1000000;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    n = atol(argv[1]);
+    break;
+  default:
+    cout << "Usage: vector-math" << endl;
+    cout << "       vector-math n" << endl;
+    exit(-1);
+  }
+
+  const VectorMathTable& VM = vector_math();
+  cout << "Selected vector math kernels: " << VM.name << endl;
+
+  // (a) Accuracy
+  auto lin = [](double lo, double hi){ return [=](double u){ return lo + u*(hi-lo); }; };
+  auto logarithmic = [](double lo, double hi){
+    return [=](double u){ return exp(log(lo) + u*(log(hi)-log(lo))); };
+  };
+  auto Exp = [](long double x){ return expl(x); };
+  auto Log = [](long double x){ return logl(x); };
+  auto Sin = [](long double x){ return sinl(x); };
+  auto Cos = [](long double x){ return cosl(x); };
+  auto Sqrt = [](long double x){ return sqrtl(x); };
+
+  cout << "Maximum error in ulp on " << n << " points (double, float):" << endl;
+  cout << "  exp  " << max_ulp<double>(VM.exp_d, Exp, lin(-700.0, 700.0), n) << ", "
+       << max_ulp<float>(VM.exp_f, Exp, lin(-87.0, 88.0), n) << endl;
+  cout << "  log  " << max_ulp<double>(VM.log_d, Log, logarithmic(1e-300, 1e300), n) << ", "
+       << max_ulp<float>(VM.log_f, Log, logarithmic(1e-37, 1e37), n) << endl;
+  cout << "  sin  " << max_ulp<double>(VM.sin_d, Sin, lin(-100.0, 100.0), n) << ", "
+       << max_ulp<float>(VM.sin_f, Sin, lin(-100.0, 100.0), n) << endl;
+  cout << "  cos  " << max_ulp<double>(VM.cos_d, Cos, lin(-100.0, 100.0), n) << ", "
+       << max_ulp<float>(VM.cos_f, Cos, lin(-100.0, 100.0), n) << endl;
+  cout << "  sqrt " << max_ulp<double>(VM.sqrt_d, Sqrt, lin(0.0, 1e6), n) << ", "
+       << max_ulp<float>(VM.sqrt_f, Sqrt, lin(0.0, 1e6), n) << endl;
+
+  // (b) Speed of cos and exp compared to <cmath>
+  const long m = 4096;
+  AlignedArray<double> x(m), y(m);
+  for (long i=0; i<m; i++)
+    x[i] = -10.0 + 20.0*i/m;
+
+  cout << "Time per element for " << m << " elements:" << endl;
+  print("  std::cos", benchmark([&](){
+        for (long i=0; i<m; i++)
+          y[i] = cos(x[i]);
+        do_not_optimize(y[0]);
+      }), m);
+  print("  std::exp", benchmark([&](){
+        for (long i=0; i<m; i++)
+          y[i] = exp(x[i]);
+        do_not_optimize(y[0]);
+      }), m);
+  for (auto& T : available_vector_math()){
+    print(string("  ") + T.name + " cos", benchmark([&](){
+          T.cos_d(x.data(), y.data(), m);
+          do_not_optimize(y[0]);
+        }), m);
+    print(string("  ") + T.name + " exp", benchmark([&](){
+          T.exp_d(x.data(), y.data(), m);
+          do_not_optimize(y[0]);
+        }), m);
+  }
+
+  // (c) Integrands
+  cout.precision(15);
+  GaussRule<double,int> GR(7);
+  DispatchedRule DR(GR);
+  const double a = 0.0, b = 2.0*M_PI, exact = 2.0*M_PI*1.266065877752008335598244625;
+  const long panels = 1000;
+
+  double IntS = 0.0, IntB = 0.0;
+  BenchmarkResult rs = benchmark([&](){
+      IntS = DR.eval([](double x){ return exp(cos(x)); }, a, b, panels);
+      do_not_optimize(IntS);
+    });
+  BenchmarkResult rb = benchmark([&](){
+      IntB = DR.eval_block([&VM](const double* X, double* F, long k){
+          VM.cos_d(X, F, k);
+          VM.exp_d(F, F, k);
+        }, a, b, panels);
+      do_not_optimize(IntB);
+    });
+  cout << "int_0^2pi exp(cos(x)) dx, 7-pt Gauss on " << panels << " panels:" << endl;
+  cout << "  <cmath>, pointwise:      " << IntS << " (error " << abs(IntS-exact) << ")" << endl;
+  cout << "  vector math, block-wise: " << IntB << " (error " << abs(IntB-exact) << ")" << endl;
+  print("  <cmath>, pointwise", rs, panels);
+  print("  vector math, block-wise", rb, panels);
+  cout.precision(15);
+
+  Function1 F1;
+  double IntF = F1.integrate(0.0, M_PI_2, 5);
+  cout << "Function1 with vcos, 5-pt Gauss on [0,pi/2]: " << IntF
+       << " (error " << abs(IntF-1.0) << ")" << endl;
+
+  // End program
+  return 0;
+}
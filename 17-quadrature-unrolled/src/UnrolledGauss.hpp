@@ -0,0 +1,219 @@
+/**
+ * \file UnrolledGauss.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements Gauss-Legendre integration with a number of
+ * points N that is known at compile time. The nodes and weights are
+ * constexpr arrays and the sum over the points is expanded by a fold
+ * expression over std::index_sequence, so that no loop remains and
+ * all constants are folded into the instructions. Since the nodes are
+ * symmetric, only the non-negative half is stored: every pair of nodes
+ * +x[k] and -x[k] shares one multiplication by the weight w[k], and the
+ * centre node of an odd rule is evaluated as f(c) without the
+ * multiplication 0.0*h.
+ *
+ * The function integrate<N>(f,a,b) is constexpr, so it can even be
+ * evaluated at compile time if f is a constexpr callable, e.g., a
+ * lambda expression without captures.
+ *
+ */
+
+#ifndef UNROLLED_GAUSS_HPP
+#define UNROLLED_GAUSS_HPP
+
+// Include header files for arrays, index sequences and exceptions
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+// Non-negative half of the N-point Gauss-Legendre rule on [-1,1]: the
+// positive nodes x[k] with weights w[k], and the weight wc of the
+// centre node 0 (zero if N is even). The values are stored in long
+// double and converted to the data type of the integral on use.
+template<int N>
+struct GaussLegendreNodes;
+
+template<>
+struct GaussLegendreNodes<1>{
+  static constexpr long double wc = 2.0L;
+  static constexpr array<long double,0> x = {};
+  static constexpr array<long double,0> w = {};
+};
+
+template<>
+struct GaussLegendreNodes<2>{
+  static constexpr long double wc = 0.0L;
+  static constexpr array<long double,1> x = {{0.5773502691896257645091488L}};
+  static constexpr array<long double,1> w = {{1.0000000000000000000000000L}};
+};
+
+template<>
+struct GaussLegendreNodes<3>{
+  static constexpr long double wc = 0.8888888888888888888888889L;
+  static constexpr array<long double,1> x = {{0.7745966692414833770358531L}};
+  static constexpr array<long double,1> w = {{0.5555555555555555555555556L}};
+};
+
+template<>
+struct GaussLegendreNodes<4>{
+  static constexpr long double wc = 0.0L;
+  static constexpr array<long double,2> x = {{0.3399810435848562648026658L,
+                                              0.8611363115940525752239465L}};
+  static constexpr array<long double,2> w = {{0.6521451548625461426269361L,
+                                              0.3478548451374538573730639L}};
+};
+
+template<>
+struct GaussLegendreNodes<5>{
+  static constexpr long double wc = 0.5688888888888888888888889L;
+  static constexpr array<long double,2> x = {{0.5384693101056830910363144L,
+                                              0.9061798459386639927976269L}};
+  static constexpr array<long double,2> w = {{0.4786286704993664680412915L,
+                                              0.2369268850561890875142640L}};
+};
+
+template<>
+struct GaussLegendreNodes<6>{
+  static constexpr long double wc = 0.0L;
+  static constexpr array<long double,3> x = {{0.2386191860831969086305017L,
+                                              0.6612093864662645136613996L,
+                                              0.9324695142031520278123016L}};
+  static constexpr array<long double,3> w = {{0.4679139345726910473898703L,
+                                              0.3607615730481386075698335L,
+                                              0.1713244923791703450402961L}};
+};
+
+template<>
+struct GaussLegendreNodes<7>{
+  static constexpr long double wc = 0.4179591836734693877551020L;
+  static constexpr array<long double,3> x = {{0.4058451513773971669066064L,
+                                              0.7415311855993944398638648L,
+                                              0.9491079123427585245261897L}};
+  static constexpr array<long double,3> w = {{0.3818300505051189449503698L,
+                                              0.2797053914892766679014678L,
+                                              0.1294849661688696932706114L}};
+};
+
+template<>
+struct GaussLegendreNodes<8>{
+  static constexpr long double wc = 0.0L;
+  static constexpr array<long double,4> x = {{0.1834346424956498049394761L,
+                                              0.5255324099163289858177390L,
+                                              0.7966664774136267395915539L,
+                                              0.9602898564975362316835609L}};
+  static constexpr array<long double,4> w = {{0.3626837833783619829651504L,
+                                              0.3137066458778872873379622L,
+                                              0.2223810344533744705443560L,
+                                              0.1012285362903762591525314L}};
+};
+
+template<>
+struct GaussLegendreNodes<9>{
+  static constexpr long double wc = 0.3302393550012597631645251L;
+  static constexpr array<long double,4> x = {{0.3242534234038089290385380L,
+                                              0.6133714327005903973087020L,
+                                              0.8360311073266357942994298L,
+                                              0.9681602395076260898355762L}};
+  static constexpr array<long double,4> w = {{0.3123470770400028400686304L,
+                                              0.2606106964029354623187429L,
+                                              0.1806481606948574040584720L,
+                                              0.0812743883615744119718922L}};
+};
+
+template<>
+struct GaussLegendreNodes<10>{
+  static constexpr long double wc = 0.0L;
+  static constexpr array<long double,5> x = {{0.1488743389816312108848260L,
+                                              0.4333953941292471907992659L,
+                                              0.6794095682990244062343274L,
+                                              0.8650633666889845107320967L,
+                                              0.9739065285171717200779640L}};
+  static constexpr array<long double,5> w = {{0.2955242247147528701738930L,
+                                              0.2692667193099963550912269L,
+                                              0.2190863625159820439955349L,
+                                              0.1494513491505805931457763L,
+                                              0.0666713443086881375935688L}};
+};
+
+// Largest number of points for which nodes are tabulated
+static constexpr int unrolled_max_points = 10;
+
+// Sum over the pairs K... of the N-point rule for the integrand f on
+// the interval with centre c and half length h. For odd N the centre
+// node is the initial value of the fold.
+template<int N, typename TData, typename TFunc, size_t... K>
+constexpr TData unrolled_sum(TFunc& f, const TData c, const TData h, index_sequence<K...>){
+  typedef GaussLegendreNodes<N> G;
+  if constexpr (N % 2 == 1)
+    return ((TData(G::wc)*f(c)) + ... +
+            (TData(G::w[K])*(f(c + TData(G::x[K])*h) + f(c - TData(G::x[K])*h))));
+  else
+    return (... +
+            (TData(G::w[K])*(f(c + TData(G::x[K])*h) + f(c - TData(G::x[K])*h))));
+}
+
+// Integral of f over [a,b] by the N-point Gauss-Legendre rule, fully
+// unrolled at compile time
+template<int N, typename TData, typename TFunc>
+constexpr TData integrate(TFunc f, TData a, TData b){
+  static_assert(N >= 1 && N <= unrolled_max_points,
+                "Number of points must be between 1 and 10.");
+  const TData h = (b-a)/TData(2);
+  const TData c = (a+b)/TData(2);
+  return unrolled_sum<N>(f, c, h, make_index_sequence<N/2>()) * h;
+}
+
+// Integral of f over [a,b] divided into p panels of equal length by
+// the composite N-point rule. Only the loop over the panels remains.
+template<int N, typename TData, typename TIndex, typename TFunc>
+constexpr TData integrate(TFunc f, TData a, TData b, TIndex p){
+  const TData H = (b-a)/TData(p);
+  TData Int = TData(0);
+  for (TIndex i=0; i<p; i++)
+    Int += integrate<N>(f, a + TData(i)*H, a + TData(i+1)*H);
+  return Int;
+}
+
+// Templated class with the interface of GaussRule from
+// 06-quadrature-oop1-templates for a number of points that is only
+// known at run time. The constructor checks n, and eval selects the
+// unrolled instantiation by comparing N with 1,...,10 once per call.
+template<typename TData=double, typename TIndex=int>
+class UnrolledGaussRule{
+
+private:
+  // Number of quadrature points
+  TIndex N;
+
+  // Dispatch to integrate<M> for the run-time number of points N
+  template<typename TFunc, int... M>
+  TData dispatch(TFunc& f, TData a, TData b, integer_sequence<int,M...>) const {
+    TData Int = TData(0);
+    ((N == M+1 ? (Int = integrate<M+1>(f, a, b), true) : false) || ...);
+    return Int;
+  }
+
+public:
+  // Constructor
+  UnrolledGaussRule(TIndex n) : N(n){
+    if (n < 1 || n > unrolled_max_points)
+      throw invalid_argument("Number of points must be between 1 and 10.");
+  }
+
+  // Number of quadrature points
+  TIndex size() const { return N; }
+
+  // Method that evaluates the integral of an arbitrary callable
+  // object over the interval [a,b]
+  template<typename TFunc>
+  TData eval(TFunc f, TData a, TData b) const {
+    return dispatch(f, a, b, make_integer_sequence<int,unrolled_max_points>());
+  }
+};
+
+#endif // UNROLLED_GAUSS_HPP
@@ -0,0 +1,137 @@
+/**
+ * \file quadrature-unrolled.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version the number of Gauss points is a template parameter.
+ * The sum over the points is expanded at compile time by a fold
+ * expression over std::index_sequence, symmetric nodes share their
+ * weight and the centre node costs no multiplication. We compare the
+ * loop of GaussRule from 06-quadrature-oop1-templates with the
+ * unrolled rule for n=3,...,8 by integrating 1/(1+x^2) over [0,1]
+ * with a composite rule, and evaluate one integral at compile time.
+ *
+ * Unrolling does not pay off here: for n >= 4 the unrolled rule is
+ * 30-50% slower than the loop (e.g. 15 ns against 10 ns per panel for
+ * n=8 with GCC 12 -O3). The vectorizer computes two iterations of the
+ * loop of GaussRule at once, i.e., four nodes with two packed
+ * divisions; the unrolled sum has no loop and no loads of nodes to
+ * start from and remains scalar, with one division per node. The
+ * division in the integrand dominates the cost.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header file for standard utility library
+#include <cstdlib>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for quadrature rules and the benchmark harness
+#include "Benchmark.hpp"
+#include "GaussRule.hpp"
+#include "UnrolledGauss.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// The integrand 1/(1+x^2) with int_0^1 f(x) dx = pi/4. A lambda
+// expression has a type of its own, so that the call is inlined into
+// the unrolled sum; a function pointer could only be inlined after
+// constant propagation.
+const auto f = [](DataType x){ return DataType(1)/(DataType(1)+x*x); };
+
+// Integrals of x^(2N-1) over [0,1] are exact; this one is computed by
+// the compiler
+constexpr DataType IntCubic = integrate<2>([](DataType x){ return x*x*x; },
+                                           DataType(0), DataType(1));
+static_assert(IntCubic > 0.25-1e-15 && IntCubic < 0.25+1e-15,
+              "2-pt Gauss rule must integrate cubic polynomials exactly.");
+
+// Compare the loop with the unrolled rule for N points on p panels
+template<int N>
+void compare(DataType a, DataType b, IndexType p){
+  // In practice the rule is set up from a run-time value; hide N from
+  // the optimizer so that it cannot unroll the loop of GaussRule
+  IndexType n = N;
+  do_not_optimize(n);
+  GaussRule<DataType,IndexType> GR(n);
+  UnrolledGaussRule<DataType,IndexType> UR(n);
+  const DataType H = (b-a)/DataType(p);
+
+  DataType IntL = 0.0, IntU = 0.0, IntR = 0.0;
+  BenchmarkResult rl = benchmark([&](){
+      IntL = 0.0;
+      for (IndexType i=0; i<p; i++)
+        IntL += GR.eval(f, a + i*H, a + (i+1)*H);
+      do_not_optimize(IntL);
+    });
+  BenchmarkResult ru = benchmark([&](){
+      IntU = integrate<N>(f, a, b, p);
+      do_not_optimize(IntU);
+    });
+  BenchmarkResult rr = benchmark([&](){
+      IntR = 0.0;
+      for (IndexType i=0; i<p; i++)
+        IntR += UR.eval(f, a + i*H, a + (i+1)*H);
+      do_not_optimize(IntR);
+    });
+
+  cout << N << "-pt Gauss on " << p << " panels: "
+       << IntL << " (loop), " << IntU << " (unrolled), error "
+       << abs(IntU-M_PI_4) << endl;
+  print("  GaussRule loop", rl, p);
+  print("  integrate<N>", ru, p);
+  print("  UnrolledGaussRule(n)", rr, p);
+  cout.precision(15);
+}
+
+// Run compare for all N in the sequence
+template<int... N>
+void compare_all(DataType a, DataType b, IndexType p, integer_sequence<int,N...>){
+  (compare<N>(a, b, p), ...);
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of panels from command line arguments
+  IndexType p=1000;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    p = atoi(argv[1]);
+    break;
+  default:
+    cout << "Usage: quadrature-unrolled" << endl;
+    cout << "       quadrature-unrolled p" << endl;
+    exit(-1);
+  }
+
+  if (p < 1){
+    cout << "Number of panels must be positive." << endl;
+    exit(-1);
+  }
+
+  cout.precision(15);
+  cout << "int_0^1 x^3 dx by 2-pt Gauss at compile time: " << IntCubic << endl;
+
+  // Time per panel for n = 3,...,8
+  compare_all(DataType(0), DataType(1), p, integer_sequence<int,3,4,5,6,7,8>());
+
+  // End program
+  return 0;
+}
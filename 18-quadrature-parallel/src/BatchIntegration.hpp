@@ -0,0 +1,231 @@
+/**
+ * \file BatchIntegration.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the parallel evaluation of many independent
+ * integrals (jobs) on a thread pool. Every job consists of an
+ * integrand f, an interval [a,b] and the number n of Gauss-Legendre
+ * points, plus the relative cost of one evaluation of f.
+ *
+ * Submitting every job as a task of its own costs a lock and a future
+ * per job, which is more than a small integral takes. Therefore the
+ * jobs are grouped into a few chunks per worker with approximately
+ * equal cost estimate n*weight. The chunks are formed by the longest
+ * processing time (LPT) rule: the jobs are sorted by decreasing cost
+ * and each one is added to the chunk with the smallest total so far.
+ * The workers take the chunks from the queue of the pool, so errors
+ * in the cost estimate are evened out dynamically.
+ *
+ */
+
+#ifndef BATCH_INTEGRATION_HPP
+#define BATCH_INTEGRATION_HPP
+
+// Include header files for algorithms, containers and function objects
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Include header file for futures
+#include <future>
+
+// Include header files for Gauss-Legendre rules, the thread pool and
+// the progress counter
+#include "GaussJacobiRule.hpp"
+#include "GaussRule.hpp"
+#include "ParallelReduction.hpp"
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+// One integral int_a^b f(x) dx by the n-point Gauss-Legendre rule;
+// weight is the cost of one evaluation of f relative to other jobs
+template<typename TData=double, typename TIndex=int>
+struct IntegrationJob{
+  function<TData(TData)> f;
+  TData  a, b;
+  TIndex n;
+  double weight;
+};
+
+// Cost estimate of a job
+template<typename TData, typename TIndex>
+double job_cost(const IntegrationJob<TData,TIndex>& job){
+  return double(job.n)*job.weight;
+}
+
+// The Gauss-Legendre rules with more than 10 points that the jobs of
+// one chunk use. The constructor of GaussJacobiRule takes the mutex of
+// the global table cache, so the workers would serialize on it if
+// every job constructed its rule; here the table is looked up once per
+// distinct n and chunk.
+template<typename TData, typename TIndex>
+class ChunkRules{
+
+private:
+  vector<pair<TIndex, GaussJacobiRule<TData,TIndex> > > rules;
+
+public:
+  const GaussJacobiRule<TData,TIndex>& get(TIndex n){
+    for (auto& r : rules)
+      if (r.first == n)
+        return r.second;
+    rules.push_back(make_pair(n, GaussJacobiRule<TData,TIndex>(n)));
+    return rules.back().second;
+  }
+};
+
+// Evaluate a job serially; the static tables of GaussRule are used for
+// n <= 10, the cached tables of GaussJacobiRule from rules otherwise.
+// The integrand is passed by reference so that it is not copied.
+template<typename TData, typename TIndex>
+TData integrate_job(const IntegrationJob<TData,TIndex>& job, ChunkRules<TData,TIndex>& rules){
+  if (job.n >= 1 && job.n <= 10){
+    GaussRule<TData,TIndex> rule(job.n);
+    return rule.eval(cref(job.f), job.a, job.b);
+  }
+  return rules.get(job.n).eval(cref(job.f), job.a, job.b);
+}
+
+// Evaluate a single job serially
+template<typename TData, typename TIndex>
+TData integrate_job(const IntegrationJob<TData,TIndex>& job){
+  ChunkRules<TData,TIndex> rules;
+  return integrate_job(job, rules);
+}
+
+// Partition the indices of jobs with the given costs into at most m
+// chunks of approximately equal total cost (LPT rule)
+inline vector<vector<size_t> > partition_by_cost(const vector<double>& cost, size_t m){
+  const size_t n = cost.size();
+  m = max<size_t>(1, min(m, n));
+
+  // Job indices by decreasing cost
+  vector<size_t> order(n);
+  iota(order.begin(), order.end(), size_t(0));
+  stable_sort(order.begin(), order.end(),
+              [&cost](size_t i, size_t j){ return cost[i] > cost[j]; });
+
+  // Min-heap of (total cost, chunk)
+  typedef pair<double,size_t> Load;
+  priority_queue<Load, vector<Load>, greater<Load> > loads;
+  for (size_t c=0; c<m; c++)
+    loads.push(Load(0.0, c));
+
+  vector<vector<size_t> > chunks(m);
+  for (size_t i : order){
+    Load l = loads.top();
+    loads.pop();
+    chunks[l.second].push_back(i);
+    l.first += cost[i];
+    loads.push(l);
+  }
+  return chunks;
+}
+
+// Partition the indices into at most m contiguous chunks of equal
+// number of jobs, ignoring the costs (for comparison)
+inline vector<vector<size_t> > partition_contiguous(size_t n, size_t m){
+  m = max<size_t>(1, min(m, n));
+  vector<vector<size_t> > chunks(m);
+  for (size_t i=0; i<n; i++)
+    chunks[i*m/n].push_back(i);
+  return chunks;
+}
+
+// Largest total cost of a chunk; the parallel run time is at least
+// proportional to it
+inline double max_chunk_cost(const vector<vector<size_t> >& chunks, const vector<double>& cost){
+  double c = 0.0;
+  for (auto& chunk : chunks){
+    double s = 0.0;
+    for (size_t i : chunk)
+      s += cost[i];
+    c = max(c, s);
+  }
+  return c;
+}
+
+// Evaluate all jobs of the given chunks on the pool and store the
+// integral of jobs[i] in result[i]. The call returns when all jobs
+// are done; the first exception thrown by a job is rethrown. If
+// progress is given, it is reset to the number of jobs and advanced
+// in batches as jobs are finished.
+template<typename TData, typename TIndex>
+void integrate_chunks(ThreadPool& pool, const vector<IntegrationJob<TData,TIndex> >& jobs,
+                      const vector<vector<size_t> >& chunks, TData* result,
+                      Progress* progress=nullptr){
+  if (progress)
+    progress->reset(long(jobs.size()));
+
+  vector<future<void> > done;
+  done.reserve(chunks.size());
+  for (auto& chunk : chunks){
+    const vector<size_t>* indices = &chunk;
+    done.push_back(pool.submit([&jobs, indices, result, progress](){
+          ChunkRules<TData,TIndex> rules;
+          long pending = 0;
+          for (size_t i : *indices){
+            result[i] = integrate_job(jobs[i], rules);
+            if (progress && ++pending == progress_batch){
+              progress->advance(pending);
+              pending = 0;
+            }
+          }
+          if (progress)
+            progress->advance(pending);
+        }));
+  }
+
+  // Wait for all chunks before an exception leaves this function,
+  // since the tasks refer to jobs, chunks and result
+  for (auto& d : done)
+    d.wait();
+  for (auto& d : done)
+    d.get();
+}
+
+// Evaluate all jobs on the pool in chunks_per_worker chunks per worker
+// that are balanced by cost and store the integral of jobs[i] in
+// result[i], see integrate_chunks
+template<typename TData, typename TIndex>
+void integrate_batch(ThreadPool& pool, const vector<IntegrationJob<TData,TIndex> >& jobs,
+                     TData* result, Progress* progress=nullptr, unsigned chunks_per_worker=4){
+  vector<double> cost(jobs.size());
+  for (size_t i=0; i<jobs.size(); i++)
+    cost[i] = job_cost(jobs[i]);
+  integrate_chunks(pool, jobs, partition_by_cost(cost, size_t(chunks_per_worker)*pool.size()),
+                   result, progress);
+}
+
+// Submit every job as a task of its own, the most expensive ones
+// first, and return one future per job. The jobs must outlive the
+// futures. Every worker thread keeps the rules of the jobs it has run
+// (see ChunkRules), so that the table cache is not locked per job.
+template<typename TData, typename TIndex>
+vector<future<TData> > integrate_async(ThreadPool& pool,
+                                       const vector<IntegrationJob<TData,TIndex> >& jobs){
+  vector<size_t> order(jobs.size());
+  iota(order.begin(), order.end(), size_t(0));
+  stable_sort(order.begin(), order.end(), [&jobs](size_t i, size_t j){
+      return job_cost(jobs[i]) > job_cost(jobs[j]);
+    });
+
+  vector<future<TData> > result(jobs.size());
+  for (size_t i : order){
+    const IntegrationJob<TData,TIndex>* job = &jobs[i];
+    result[i] = pool.submit([job](){
+        static thread_local ChunkRules<TData,TIndex> rules;
+        return integrate_job(*job, rules);
+      });
+  }
+  return result;
+}
+
+#endif // BATCH_INTEGRATION_HPP
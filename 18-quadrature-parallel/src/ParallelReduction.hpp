@@ -0,0 +1,166 @@
+/**
+ * \file ParallelReduction.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the reduction of partial integrals and the
+ * progress reporting for parallel integration drivers without locks.
+ *
+ * Every task adds its contributions to a slot of its own, and the
+ * slots are summed in a fixed order at the end, so the result does not
+ * depend on the scheduling. Each slot fills a full cache line (64
+ * bytes). Otherwise several slots would share a line, and every write
+ * by one core would invalidate the copy of that line held by the other
+ * cores (false sharing).
+ *
+ * Progress is counted by an atomic counter that the workers increment
+ * with relaxed memory order and that another thread may poll at any
+ * time. Workers publish their progress in batches, so the shared
+ * counter is touched rarely.
+ *
+ */
+
+#ifndef PARALLEL_REDUCTION_HPP
+#define PARALLEL_REDUCTION_HPP
+
+// Include header files for containers and atomic operations
+#include <atomic>
+#include <vector>
+
+// Include header file for futures
+#include <future>
+
+// Include header file for exceptions
+#include <stdexcept>
+
+// Include header files for aligned arrays, the Gauss rule and the
+// thread pool
+#include "AlignedArray.hpp"
+#include "GaussRule.hpp"
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+// A value that occupies a cache line of its own
+template<typename T>
+struct alignas(64) Padded{
+  T value;
+};
+
+// Templated class with one padded accumulator per task
+template<typename TData=double>
+class PerTaskAccumulator{
+
+private:
+  // The array is 64-byte aligned, which std::vector only guarantees
+  // for over-aligned types with C++17
+  AlignedArray<Padded<TData> > slots;
+
+public:
+  // Constructor: n accumulators, initialized to zero
+  explicit PerTaskAccumulator(size_t n) : slots(n){
+    for (size_t i=0; i<n; i++)
+      slots[i].value = TData(0);
+  }
+
+  // Number of accumulators
+  size_t size() const { return slots.size(); }
+
+  // Accumulator of task i; only task i may write to it
+  TData& operator[](size_t i){ return slots[i].value; }
+
+  // Sum of all accumulators in the order of the tasks
+  TData total() const {
+    TData s = TData(0);
+    for (size_t i=0; i<slots.size(); i++)
+      s += slots[i].value;
+    return s;
+  }
+};
+
+// Lock-free progress counter: workers add the number of finished work
+// items, a monitoring thread polls done() or fraction(). The total is
+// atomic as well, since reset may run while the monitor is polling.
+class Progress{
+
+private:
+  atomic<long> count;
+  atomic<long> total;
+
+public:
+  // Constructor for the given total number of work items
+  explicit Progress(long total=0) : count(0), total(total){}
+
+  // Reset for a new run with the given total number of work items
+  void reset(long n){
+    total.store(n, memory_order_relaxed);
+    count.store(0, memory_order_relaxed);
+  }
+
+  // Add k finished items; relaxed order suffices since the counter
+  // does not protect any other data
+  void advance(long k=1){ count.fetch_add(k, memory_order_relaxed); }
+
+  // Number and fraction of finished items
+  long done() const { return count.load(memory_order_relaxed); }
+  double fraction() const {
+    const long n = total.load(memory_order_relaxed);
+    return n > 0 ? double(done())/double(n) : 1.0;
+  }
+
+  // Whether updates of the counter never take a lock
+  bool is_lock_free() const { return count.is_lock_free(); }
+};
+
+// Number of panels after which a task publishes its progress
+static const long progress_batch = 256;
+
+// Evaluate the integral of f over [a,b] by the composite n-point Gauss
+// rule on p panels in parallel. The panels are split into contiguous
+// ranges, one task per range, chunks_per_worker ranges per worker.
+// Each task sums its panels into its own padded accumulator; the
+// accumulators are summed in task order at the end. If progress is
+// given, it is reset to p and advanced as panels are finished.
+template<typename TData, typename TIndex, typename TFunc>
+TData parallel_composite(ThreadPool& pool, TFunc f, TData a, TData b, TIndex n, long p,
+                         Progress* progress=nullptr, unsigned chunks_per_worker=4){
+  if (p < 1)
+    throw invalid_argument("Number of panels must be positive.");
+  if (progress)
+    progress->reset(p);
+
+  const long m = min(long(chunks_per_worker)*long(pool.size()), p);
+  const TData H = (b-a)/TData(p);
+  PerTaskAccumulator<TData> acc(static_cast<size_t>(m));
+
+  vector<future<void> > done;
+  done.reserve(size_t(m));
+  for (long t=0; t<m; t++)
+    done.push_back(pool.submit([&, t](){
+          GaussRule<TData,TIndex> rule(n);
+          const long first = t*p/m, last = (t+1)*p/m;
+          TData& sum = acc[size_t(t)];
+          long pending = 0;
+          for (long i=first; i<last; i++){
+            sum += rule.eval(f, a + TData(i)*H, a + TData(i+1)*H);
+            if (progress && ++pending == progress_batch){
+              progress->advance(pending);
+              pending = 0;
+            }
+          }
+          if (progress)
+            progress->advance(pending);
+        }));
+
+  // Wait for all tasks before an exception leaves this function,
+  // since the tasks refer to the local variables
+  for (auto& d : done)
+    d.wait();
+  for (auto& d : done)
+    d.get();
+  return acc.total();
+}
+
+#endif // PARALLEL_REDUCTION_HPP
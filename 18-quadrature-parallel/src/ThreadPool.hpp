@@ -0,0 +1,163 @@
+/**
+ * \file ThreadPool.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements a fixed pool of worker threads that execute
+ * tasks from a common queue. A task is any callable without
+ * arguments; submit returns a std::future for its result, which also
+ * transports an exception thrown by the task to the caller.
+ *
+ * Creating a thread costs tens of microseconds, so for many small
+ * tasks a pool is much cheaper than std::async(launch::async, ...),
+ * which may start a new thread per call.
+ *
+ * Optionally, the workers are pinned to the CPUs that the process may
+ * run on (Linux only). Worker i runs on the i-th allowed CPU, so that
+ * the workers fill one NUMA node (CPUs are usually numbered node by
+ * node) before the next one is used, and memory that a worker touches
+ * first stays local to it.
+ *
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+// Include header files for containers and function objects
+#include <deque>
+#include <functional>
+#include <vector>
+
+// Include header files for threads, synchronization and futures
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+
+// Include header files for smart pointers and exceptions
+#include <memory>
+#include <stdexcept>
+
+// Include header file for the CPU affinity of threads
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+class ThreadPool{
+
+private:
+  // Worker threads
+  vector<thread> workers;
+
+  // Queue of tasks, protected by mutex; the workers wait on cv
+  deque<function<void()> > tasks;
+  mutex m;
+  condition_variable cv;
+  bool stop;
+
+  // Whether the workers are pinned to CPUs
+  bool pinned;
+
+  // Main loop of a worker: take a task from the queue and run it
+  // until the pool is destroyed and the queue is empty
+  void work(){
+    for (;;){
+      function<void()> task;
+      {
+        unique_lock<mutex> lock(m);
+        cv.wait(lock, [this](){ return stop || !tasks.empty(); });
+        if (stop && tasks.empty())
+          return;
+        task = move(tasks.front());
+        tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  // Pin the calling thread to the i-th CPU the process may run on
+  static bool pin(unsigned i){
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+      return false;
+    const int count = CPU_COUNT(&allowed);
+    if (count == 0)
+      return false;
+
+    int k = int(i % unsigned(count));
+    for (int cpu=0; cpu<CPU_SETSIZE; cpu++)
+      if (CPU_ISSET(cpu, &allowed) && k-- == 0){
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+      }
+#else
+    (void)i;
+#endif
+    return false;
+  }
+
+public:
+  // Constructor: start n workers (by default one per hardware thread)
+  // and optionally pin them to CPUs
+  explicit ThreadPool(unsigned n=thread::hardware_concurrency(), bool pin_threads=false)
+    : stop(false), pinned(pin_threads){
+    if (n == 0)
+      n = 1;
+    workers.reserve(n);
+    for (unsigned i=0; i<n; i++)
+      workers.emplace_back([this, i](){
+          if (pinned)
+            pin(i);
+          work();
+        });
+  }
+
+  // The pool can neither be copied nor moved since the workers refer
+  // to it
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Destructor: run the remaining tasks and join the workers
+  ~ThreadPool(){
+    {
+      lock_guard<mutex> lock(m);
+      stop = true;
+    }
+    cv.notify_all();
+    for (auto& t : workers)
+      t.join();
+  }
+
+  // Number of workers and whether they were asked to be pinned
+  unsigned size() const { return unsigned(workers.size()); }
+  bool is_pinned() const { return pinned; }
+
+  // Submit a task f() and return a future for its result. The
+  // packaged task is held by a shared pointer since std::function
+  // requires a copyable callable.
+  template<typename TFunc>
+  auto submit(TFunc f) -> future<decltype(f())> {
+    typedef decltype(f()) TResult;
+    auto task = make_shared<packaged_task<TResult()> >(move(f));
+    future<TResult> result = task->get_future();
+    {
+      lock_guard<mutex> lock(m);
+      if (stop)
+        throw runtime_error("Task submitted to a stopped thread pool.");
+      tasks.emplace_back([task](){ (*task)(); });
+    }
+    cv.notify_one();
+    return result;
+  }
+};
+
+#endif // THREAD_POOL_HPP
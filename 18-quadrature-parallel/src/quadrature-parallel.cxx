@@ -0,0 +1,275 @@
+/**
+ * \file quadrature-parallel.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we evaluate many independent integrals, one per
+ * parameter set, in parallel on a thread pool. The jobs differ in the
+ * number of points and in the cost of the integrand, so chunks with an
+ * equal number of jobs take very different times. We compare them
+ * with chunks that are balanced by a cost estimate, with one task per
+ * job, and with pinned worker threads.
+ *
+ * Finally, we measure the cost of combining the partial results of
+ * the workers: a shared sum protected by a mutex, an atomic sum,
+ * per-thread sums in adjacent memory (false sharing) and per-thread
+ * sums in cache lines of their own, and a composite rule whose
+ * progress is polled by a monitoring thread.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header files for standard utility library and timing
+#include <chrono>
+#include <cstdlib>
+
+// Include header files for threads and synchronization
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for the thread pool, batch integration and
+// the reduction of partial results
+#include "BatchIntegration.hpp"
+#include "ParallelReduction.hpp"
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// Wall-clock time of f() in seconds
+template<typename TFunc>
+double seconds(TFunc f){
+  auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now()-start).count();
+}
+
+// Number of results that differ from the reference
+size_t mismatches(const vector<DataType>& r, const vector<DataType>& ref){
+  size_t k = 0;
+  for (size_t i=0; i<r.size(); i++)
+    k += (r[i] != ref[i]);
+  return k;
+}
+
+// Run body(t) on t=0,...,threads-1 concurrently and return the
+// wall-clock time in seconds
+template<typename TFunc>
+double run_threads(unsigned threads, TFunc body){
+  return seconds([&](){
+      vector<thread> team;
+      for (unsigned t=0; t<threads; t++)
+        team.emplace_back(body, t);
+      for (auto& th : team)
+        th.join();
+    });
+}
+
+// Contention benchmark: every thread adds k values to a common result
+void contention_benchmark(unsigned threads, long k){
+  const double items = double(threads)*double(k);
+  cout << "Reduction of " << threads << " x " << k << " values, time per value:" << endl;
+
+  double shared = 0.0;
+  mutex m;
+  double t = run_threads(threads, [&](unsigned){
+      for (long i=0; i<k; i++){
+        lock_guard<mutex> lock(m);
+        shared += 1.0;
+      }
+    });
+  cout << "  mutex:                " << 1e9*t/items << " ns (sum " << shared << ")" << endl;
+
+  // Atomic read-modify-write of a double by compare-and-swap
+  atomic<double> sum(0.0);
+  t = run_threads(threads, [&](unsigned){
+      for (long i=0; i<k; i++){
+        double old = sum.load(memory_order_relaxed);
+        while (!sum.compare_exchange_weak(old, old + 1.0, memory_order_relaxed))
+          ;
+      }
+    });
+  cout << "  atomic CAS:           " << 1e9*t/items << " ns (sum " << sum.load() << ")" << endl;
+
+  // Per-thread sums next to each other: the volatile accesses force a
+  // store per value, as when the sum is updated across calls to an
+  // integrand the compiler cannot see into
+  vector<double> adjacent(threads, 0.0);
+  t = run_threads(threads, [&](unsigned id){
+      volatile double* s = &adjacent[id];
+      for (long i=0; i<k; i++)
+        *s = *s + 1.0;
+    });
+  double total = 0.0;
+  for (double v : adjacent)
+    total += v;
+  cout << "  per-thread, adjacent: " << 1e9*t/items << " ns (sum " << total << ")" << endl;
+
+  PerTaskAccumulator<double> padded(threads);
+  t = run_threads(threads, [&](unsigned id){
+      volatile double* s = &padded[id];
+      for (long i=0; i<k; i++)
+        *s = *s + 1.0;
+    });
+  cout << "  per-thread, padded:   " << 1e9*t/items << " ns (sum " << padded.total() << ")" << endl;
+
+  // Progress counter updated per value and in batches
+  Progress progress(static_cast<long>(items));
+  t = run_threads(threads, [&](unsigned){
+      for (long i=0; i<k; i++)
+        progress.advance();
+    });
+  cout << "  progress, per value:  " << 1e9*t/items << " ns (count " << progress.done() << ")" << endl;
+
+  progress.reset(long(items));
+  t = run_threads(threads, [&](unsigned){
+      long pending = 0;
+      for (long i=0; i<k; i++)
+        if (++pending == progress_batch){
+          progress.advance(pending);
+          pending = 0;
+        }
+      progress.advance(pending);
+    });
+  cout << "  progress, batched:    " << 1e9*t/items << " ns (count " << progress.done() << ")" << endl;
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of threads and jobs from command line arguments
+  unsigned threads = thread::hardware_concurrency();
+  size_t   njobs   = 20000;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 3:
+    njobs = size_t(atol(argv[2]));
+    // fall through
+  case 2:
+    threads = unsigned(atoi(argv[1]));
+    break;
+  default:
+    cout << "Usage: quadrature-parallel" << endl;
+    cout << "       quadrature-parallel threads" << endl;
+    cout << "       quadrature-parallel threads jobs" << endl;
+    exit(-1);
+  }
+
+  if (threads == 0)
+    threads = 1;
+
+  // Parameter study: int_0^1 cos(omega*x) dx for many omega. The first
+  // quarter of the jobs uses an expensive integrand (a sum of 20
+  // cosines, weight 20) and many points, the rest a cheap one.
+  vector<IntegrationJob<DataType,IndexType> > jobs(njobs);
+  for (size_t i=0; i<njobs; i++){
+    const DataType omega = 1.0 + DataType(i % 100)/10.0;
+    if (i < njobs/4){
+      jobs[i].f = [omega](DataType x){
+        DataType s = 0.0;
+        for (int j=1; j<=20; j++)
+          s += cos(omega*x/j);
+        return s;
+      };
+      jobs[i].n = 40;
+      jobs[i].weight = 20.0;
+    } else {
+      jobs[i].f = [omega](DataType x){ return cos(omega*x); };
+      jobs[i].n = 2 + IndexType(i % 9);
+      jobs[i].weight = 1.0;
+    }
+    jobs[i].a = 0.0;
+    jobs[i].b = 1.0;
+  }
+
+  vector<double> cost(njobs);
+  for (size_t i=0; i<njobs; i++)
+    cost[i] = job_cost(jobs[i]);
+
+  // Serial reference, which looks up the Gauss-Jacobi rules once like
+  // every chunk of the parallel runs
+  vector<DataType> ref(njobs), r(njobs);
+  double ts = seconds([&](){
+      ChunkRules<DataType,IndexType> rules;
+      for (size_t i=0; i<njobs; i++)
+        ref[i] = integrate_job(jobs[i], rules);
+    });
+
+  ThreadPool pool(threads);
+  const size_t nchunks = 4*pool.size();
+  auto contiguous = partition_contiguous(njobs, nchunks);
+  auto balanced   = partition_by_cost(cost, nchunks);
+
+  cout << njobs << " jobs on " << pool.size() << " thread(s), "
+       << nchunks << " chunks" << endl;
+  cout << "Largest chunk cost / average chunk cost:" << endl;
+  const double avg = accumulate(cost.begin(), cost.end(), 0.0)/double(nchunks);
+  cout << "  contiguous chunks: " << max_chunk_cost(contiguous, cost)/avg << endl;
+  cout << "  LPT chunks:        " << max_chunk_cost(balanced, cost)/avg << endl;
+
+  cout << "Wall-clock time:" << endl;
+  cout << "  serial:                " << ts << " s" << endl;
+
+  double tc = seconds([&](){ integrate_chunks(pool, jobs, contiguous, r.data()); });
+  cout << "  contiguous chunks:     " << tc << " s, speedup " << ts/tc
+       << ", mismatches " << mismatches(r, ref) << endl;
+
+  double tb = seconds([&](){ integrate_batch(pool, jobs, r.data()); });
+  cout << "  LPT chunks:            " << tb << " s, speedup " << ts/tb
+       << ", mismatches " << mismatches(r, ref) << endl;
+
+  double ta = seconds([&](){
+      auto futures = integrate_async(pool, jobs);
+      for (size_t i=0; i<njobs; i++)
+        r[i] = futures[i].get();
+    });
+  cout << "  one task per job:      " << ta << " s, speedup " << ts/ta
+       << ", mismatches " << mismatches(r, ref) << endl;
+
+  ThreadPool pinned(threads, true);
+  double tp = seconds([&](){ integrate_batch(pinned, jobs, r.data()); });
+  cout << "  LPT chunks, pinned:    " << tp << " s, speedup " << ts/tp
+       << ", mismatches " << mismatches(r, ref) << endl;
+
+  // Contention of the reduction
+  contention_benchmark(max(threads, 2u), 2000000);
+
+  // Composite rule with a monitoring thread that polls the progress
+  cout.precision(15);
+  Progress progress;
+  cout << "Progress counter is lock-free: " << (progress.is_lock_free() ? "yes" : "no") << endl;
+  atomic<bool> finished(false);
+  thread monitor([&](){
+      while (!finished.load()){
+        this_thread::sleep_for(chrono::milliseconds(100));
+        cout << "  progress " << int(100.0*progress.fraction()) << "%" << endl;
+      }
+    });
+  const long panels = 2000000;
+  DataType Int = parallel_composite(pool, [](DataType x){ return exp(cos(x)); },
+                                    DataType(0), DataType(2.0*M_PI), IndexType(7), panels,
+                                    &progress);
+  finished = true;
+  monitor.join();
+  cout << "int_0^2pi exp(cos(x)) dx, 7-pt Gauss on " << panels << " panels: " << Int
+       << " (error " << abs(Int - 2.0*M_PI*1.266065877752008335598244625) << ")" << endl;
+
+  // End program
+  return 0;
+}
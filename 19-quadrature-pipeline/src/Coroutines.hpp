@@ -0,0 +1,238 @@
+/**
+ * \file Coroutines.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the building blocks of a pipeline of C++20
+ * coroutines that run on thread pools:
+ *
+ * - Task: a coroutine that starts immediately and whose completion
+ *   (or exception) can be waited for from ordinary code,
+ * - Generator<T>: a coroutine that produces values by co_yield on
+ *   demand,
+ * - schedule_on(pool): an awaitable that moves the coroutine to a
+ *   worker of the pool,
+ * - AsyncQueue<T>: a bounded queue whose push and pop suspend the
+ *   coroutine instead of blocking the thread if the queue is full or
+ *   empty.
+ *
+ * A suspended coroutine does not occupy a thread. When the reason for
+ * the suspension is gone, the coroutine is resumed as a task on the
+ * pool that it named when it suspended, so every stage stays on its
+ * pool (e.g., I/O stages on a small pool of their own and compute
+ * stages on a pool with one worker per core).
+ *
+ */
+
+#ifndef COROUTINES_HPP
+#define COROUTINES_HPP
+
+// Include header files for coroutines, containers and optional values
+#include <coroutine>
+#include <deque>
+#include <optional>
+
+// Include header files for futures, mutexes and exceptions
+#include <exception>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+
+// Include header file for the thread pool
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+// Coroutine that starts immediately; wait() blocks the calling
+// (ordinary) thread until the coroutine has finished and rethrows an
+// exception that escaped from it
+class Task{
+
+public:
+  struct promise_type{
+    promise<void> done;
+
+    Task get_return_object(){ return Task(done.get_future()); }
+    suspend_never initial_suspend() noexcept { return {}; }
+    suspend_never final_suspend() noexcept { return {}; }
+    void return_void(){ done.set_value(); }
+    void unhandled_exception(){ done.set_exception(current_exception()); }
+  };
+
+  void wait(){ finished.get(); }
+
+private:
+  explicit Task(future<void> f) : finished(move(f)){}
+  future<void> finished;
+};
+
+// Coroutine that computes a sequence of values lazily: next() resumes
+// the coroutine until its next co_yield and returns the value, or
+// nullopt after co_return
+template<typename T>
+class Generator{
+
+public:
+  struct promise_type{
+    optional<T>   value;
+    exception_ptr error;
+
+    Generator get_return_object(){
+      return Generator(coroutine_handle<promise_type>::from_promise(*this));
+    }
+    suspend_always initial_suspend() noexcept { return {}; }
+    suspend_always final_suspend() noexcept { return {}; }
+    suspend_always yield_value(T v){ value = move(v); return {}; }
+    void return_void(){}
+    void unhandled_exception(){ error = current_exception(); }
+  };
+
+  // Generators can be moved but not copied
+  Generator(Generator&& other) noexcept : h(other.h){ other.h = nullptr; }
+  Generator(const Generator&) = delete;
+  Generator& operator=(const Generator&) = delete;
+  Generator& operator=(Generator&&) = delete;
+
+  ~Generator(){ if (h) h.destroy(); }
+
+  optional<T> next(){
+    if (!h || h.done())
+      return nullopt;
+    h.promise().value.reset();
+    h.resume();
+    if (h.promise().error)
+      rethrow_exception(h.promise().error);
+    return move(h.promise().value);
+  }
+
+private:
+  explicit Generator(coroutine_handle<promise_type> h) : h(h){}
+  coroutine_handle<promise_type> h;
+};
+
+// Resume the coroutine h as a task on the pool
+inline void resume_on(ThreadPool& pool, coroutine_handle<> h){
+  pool.submit([h](){ h.resume(); });
+}
+
+// Awaitable that continues the awaiting coroutine on a worker of the
+// pool. Nothing may be touched after submit, since the coroutine may
+// already run (and finish) on the worker.
+struct ScheduleAwaiter{
+  ThreadPool& pool;
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(coroutine_handle<> h){ resume_on(pool, h); }
+  void await_resume() const noexcept {}
+};
+
+inline ScheduleAwaiter schedule_on(ThreadPool& pool){ return ScheduleAwaiter{pool}; }
+
+// Bounded queue between two stages. co_await push(value, pool)
+// suspends while the queue is full, co_await pop(pool) suspends while
+// it is empty and returns nullopt once the queue is closed and empty.
+// A value is handed directly to a waiting consumer if there is one.
+template<typename T>
+class AsyncQueue{
+
+private:
+  // Suspended coroutine, the pool to resume it on and its value
+  struct Waiter{
+    coroutine_handle<> h;
+    ThreadPool*        pool;
+    optional<T>*       slot;
+  };
+
+  mutex         m;
+  deque<T>      items;
+  deque<Waiter> poppers, pushers;
+  size_t        capacity;
+  bool          closed;
+
+public:
+  // Constructor for a queue of at most capacity values
+  explicit AsyncQueue(size_t capacity) : capacity(capacity), closed(false){
+    if (capacity == 0)
+      throw invalid_argument("Capacity of the queue must be positive.");
+  }
+
+  struct PushAwaiter{
+    AsyncQueue& q;
+    ThreadPool& pool;
+    optional<T> value;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(coroutine_handle<> h){
+      unique_lock<mutex> lock(q.m);
+      if (q.closed)
+        throw logic_error("Value pushed to a closed queue.");
+      if (!q.poppers.empty()){
+        Waiter w = q.poppers.front();
+        q.poppers.pop_front();
+        *w.slot = move(value);
+        lock.unlock();
+        resume_on(*w.pool, w.h);
+        return false;
+      }
+      if (q.items.size() < q.capacity){
+        q.items.push_back(move(*value));
+        return false;
+      }
+      q.pushers.push_back(Waiter{h, &pool, &value});
+      return true;
+    }
+    void await_resume() const noexcept {}
+  };
+
+  struct PopAwaiter{
+    AsyncQueue& q;
+    ThreadPool& pool;
+    optional<T> value;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(coroutine_handle<> h){
+      unique_lock<mutex> lock(q.m);
+      if (!q.items.empty()){
+        value = move(q.items.front());
+        q.items.pop_front();
+        // A pusher can only wait if the queue was full; its value
+        // takes the place that has just become free
+        if (!q.pushers.empty()){
+          Waiter w = q.pushers.front();
+          q.pushers.pop_front();
+          q.items.push_back(move(**w.slot));
+          lock.unlock();
+          resume_on(*w.pool, w.h);
+        }
+        return false;
+      }
+      if (q.closed)
+        return false;
+      q.poppers.push_back(Waiter{h, &pool, &value});
+      return true;
+    }
+    optional<T> await_resume(){ return move(value); }
+  };
+
+  // Awaitables for the producer and the consumer; the coroutine is
+  // resumed on pool if it has to wait
+  PushAwaiter push(T value, ThreadPool& pool){ return PushAwaiter{*this, pool, move(value)}; }
+  PopAwaiter pop(ThreadPool& pool){ return PopAwaiter{*this, pool, nullopt}; }
+
+  // Close the queue: no more values are pushed, and waiting consumers
+  // are resumed with nullopt
+  void close(){
+    deque<Waiter> waiting;
+    {
+      lock_guard<mutex> lock(m);
+      closed = true;
+      waiting.swap(poppers);
+    }
+    for (auto& w : waiting)
+      resume_on(*w.pool, w.h);
+  }
+};
+
+#endif // COROUTINES_HPP
@@ -0,0 +1,302 @@
+/**
+ * \file quadrature-pipeline.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we process a file of integration jobs in three
+ * stages: reading batches of jobs, integrating them and writing the
+ * results. Run one after another, as in all previous examples, the
+ * stages add up. Here they are C++20 coroutines connected by bounded
+ * queues: the reader and the writer run on a small I/O pool, the
+ * integration on a compute pool, and all stages work on different
+ * batches at the same time. The storage latency is simulated by a
+ * delay per batch, so that the overlap is visible even on one core.
+ */
+
+// Include header files for standard input/output stream library and
+// files
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Include header files for standard utility library, containers and
+// timing
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <thread>
+#include <vector>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for coroutines, thread pools and jobs
+#include "BatchIntegration.hpp"
+#include "Coroutines.hpp"
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+typedef IntegrationJob<DataType,IndexType> Job;
+
+// A batch of jobs and the batch of their results
+struct JobBatch{
+  size_t      index;
+  vector<Job> jobs;
+};
+
+struct ResultBatch{
+  size_t           index;
+  vector<DataType> values;
+};
+
+// Wall-clock time of f() in seconds
+template<typename TFunc>
+double seconds(TFunc f){
+  auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now()-start).count();
+}
+
+// Simulated latency of the storage per batch
+void io_latency(double ms){
+  this_thread::sleep_for(chrono::duration<double,milli>(ms));
+}
+
+// Read the jobs "omega n" line by line and yield them in batches;
+// the integrand is sum_{j=1}^{10} cos(j*omega*x)/j on [0,1]
+Generator<JobBatch> read_batches(istream& in, size_t size, double delay){
+  JobBatch batch{0, {}};
+  DataType omega;
+  IndexType n;
+  while (in >> omega >> n){
+    Job job;
+    job.f = [omega](DataType x){
+      DataType s = 0.0;
+      for (int j=1; j<=10; j++)
+        s += cos(j*omega*x)/j;
+      return s;
+    };
+    job.a = 0.0;
+    job.b = 1.0;
+    job.n = n;
+    job.weight = 1.0;
+    batch.jobs.push_back(move(job));
+    if (batch.jobs.size() == size){
+      io_latency(delay);
+      co_yield move(batch);
+      batch = JobBatch{batch.index+1, {}};
+    }
+  }
+  if (!batch.jobs.empty()){
+    io_latency(delay);
+    co_yield move(batch);
+  }
+}
+
+// Write the results of a batch
+void write_batch(ostream& out, const vector<DataType>& values, double delay){
+  for (DataType v : values)
+    out << v << "\n";
+  io_latency(delay);
+}
+
+// Stage 1: push the batches from the generator into the queue. The
+// queue is closed on every exit, also if reading fails, so that the
+// integrators do not wait for more batches.
+Task reader(ThreadPool& io, Generator<JobBatch>& batches, AsyncQueue<JobBatch>& out){
+  co_await schedule_on(io);
+  exception_ptr error;
+  try{
+    while (auto batch = batches.next())
+      co_await out.push(move(*batch), io);
+  }
+  catch (...){
+    error = current_exception();
+  }
+  out.close();
+  if (error)
+    rethrow_exception(error);
+}
+
+// Stage 2: integrate batches; several integrators run on the compute
+// pool, and the last one to finish closes the output queue. Every
+// integrator keeps its own Gauss-Jacobi rules (see ChunkRules), so that
+// the integrators do not meet at the lock of the table cache for every
+// job. After an exception an integrator only drains its input, so that
+// the reader is not blocked by a full queue, and rethrows the exception
+// at the end.
+Task integrator(ThreadPool& compute, AsyncQueue<JobBatch>& in, AsyncQueue<ResultBatch>& out,
+                atomic<int>& active){
+  co_await schedule_on(compute);
+  ChunkRules<DataType,IndexType> rules;
+  exception_ptr error;
+  while (auto batch = co_await in.pop(compute)){
+    if (error)
+      continue;
+    try{
+      ResultBatch result{batch->index, vector<DataType>(batch->jobs.size())};
+      for (size_t i=0; i<batch->jobs.size(); i++)
+        result.values[i] = integrate_job(batch->jobs[i], rules);
+      co_await out.push(move(result), compute);
+    }
+    catch (...){
+      error = current_exception();
+    }
+  }
+  if (--active == 0)
+    out.close();
+  if (error)
+    rethrow_exception(error);
+}
+
+// Stage 3: write the results in the order of the batches, which may
+// arrive out of order
+Task writer(ThreadPool& io, AsyncQueue<ResultBatch>& in, ostream& out, double delay){
+  co_await schedule_on(io);
+  map<size_t, vector<DataType> > pending;
+  size_t next = 0;
+  while (auto result = co_await in.pop(io)){
+    pending[result->index] = move(result->values);
+    for (auto it = pending.find(next); it != pending.end(); it = pending.find(++next)){
+      write_batch(out, it->second, delay);
+      pending.erase(it);
+    }
+  }
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of jobs, batch size and simulated latency per batch in
+  // milliseconds from command line arguments
+  size_t njobs = 25600, size = 256;
+  double delay = 0.5;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 4:
+    delay = atof(argv[3]);
+    // fall through
+  case 3:
+    size = size_t(atol(argv[2]));
+    njobs = size_t(atol(argv[1]));
+    break;
+  default:
+    cout << "Usage: quadrature-pipeline" << endl;
+    cout << "       quadrature-pipeline jobs batchsize [latency in ms]" << endl;
+    exit(-1);
+  }
+
+  if (size == 0){
+    cout << "Batch size must be positive." << endl;
+    exit(-1);
+  }
+
+  // Input file with one job "omega n" per line
+  const filesystem::path dir = filesystem::temp_directory_path();
+  const filesystem::path input = dir / "quadrature-pipeline-jobs.txt";
+  const filesystem::path output_seq = dir / "quadrature-pipeline-sequential.txt";
+  const filesystem::path output_pipe = dir / "quadrature-pipeline-coroutines.txt";
+  {
+    ofstream out(input);
+    for (size_t i=0; i<njobs; i++)
+      out << 1.0 + double(i % 100)/10.0 << " " << 20 + int(i % 21) << "\n";
+  }
+
+  ThreadPool compute(thread::hardware_concurrency()), io(2);
+  const size_t nbatches = (njobs+size-1)/size;
+  cout << njobs << " jobs in " << nbatches << " batches, " << compute.size()
+       << " compute thread(s), latency " << delay << " ms per batch read and written" << endl;
+
+  // (a) Stages one after another: read all, integrate all, write all
+  double tread = 0.0, tint = 0.0, twrite = 0.0;
+  {
+    ifstream in(input);
+    ofstream out(output_seq);
+    out.precision(17);
+    vector<JobBatch> batches;
+    vector<vector<DataType> > results;
+    tread = seconds([&](){
+        Generator<JobBatch> gen = read_batches(in, size, delay);
+        while (auto batch = gen.next())
+          batches.push_back(move(*batch));
+      });
+    tint = seconds([&](){
+        for (auto& batch : batches){
+          results.emplace_back(batch.jobs.size());
+          integrate_batch(compute, batch.jobs, results.back().data());
+        }
+      });
+    twrite = seconds([&](){
+        for (auto& r : results)
+          write_batch(out, r, delay);
+      });
+  }
+  cout << "Sequential stages: read " << tread << " s, integrate " << tint
+       << " s, write " << twrite << " s, total " << tread+tint+twrite << " s" << endl;
+
+  // (b) Coroutine pipeline with queues of at most 4 batches
+  double tpipe = seconds([&](){
+      ifstream in(input);
+      ofstream out(output_pipe);
+      out.precision(17);
+      Generator<JobBatch> gen = read_batches(in, size, delay);
+      AsyncQueue<JobBatch> jobs(4);
+      AsyncQueue<ResultBatch> results(4);
+      atomic<int> active(int(compute.size()));
+
+      vector<Task> tasks;
+      tasks.push_back(reader(io, gen, jobs));
+      for (unsigned i=0; i<compute.size(); i++)
+        tasks.push_back(integrator(compute, jobs, results, active));
+      tasks.push_back(writer(io, results, out, delay));
+
+      // Wait for all stages before an exception leaves this scope,
+      // since the coroutines refer to the queues, the generator and the
+      // files; then rethrow the first exception
+      exception_ptr error;
+      for (auto& t : tasks){
+        try{
+          t.wait();
+        }
+        catch (...){
+          if (!error)
+            error = current_exception();
+        }
+      }
+      if (error)
+        rethrow_exception(error);
+    });
+  cout << "Coroutine pipeline: total " << tpipe << " s, speedup "
+       << (tread+tint+twrite)/tpipe << endl;
+
+  // Both runs must write identical files
+  auto contents = [](const filesystem::path& p){
+    ifstream in(p);
+    stringstream s;
+    s << in.rdbuf();
+    return s.str();
+  };
+  cout << "Outputs identical: " << (contents(output_seq) == contents(output_pipe) ? "yes" : "no")
+       << endl;
+
+  filesystem::remove(input);
+  filesystem::remove(output_seq);
+  filesystem::remove(output_pipe);
+
+  // End program
+  return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * \file MPIIntegration.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements integration drivers for distributed memory
+ * with MPI. Every process (rank) of a communicator evaluates its share
+ * of the work and the partial results are combined by collective
+ * operations, so that all ranks obtain the full result:
+ *
+ * - mpi_composite splits the panels of a composite rule into
+ *   contiguous ranges of (almost) equal length, one per rank, and sums
+ *   the partial integrals by MPI_Allreduce,
+ *
+ * - mpi_sweep distributes a sweep of independent integrals cyclically
+ *   (job i on rank i mod size), which balances jobs whose cost grows or
+ *   shrinks along the sweep, and collects all results on all ranks.
+ *
+ * The same code runs in several processes on one host (e.g., mpirun
+ * -np 8) and on several nodes. The integrand is any callable, e.g., a
+ * lambda expression or a function object derived from FunctionBase
+ * (passed with std::ref since FunctionBase is abstract).
+ *
+ */
+
+#ifndef MPI_INTEGRATION_HPP
+#define MPI_INTEGRATION_HPP
+
+// Include header files for containers, limits and exceptions
+#include <climits>
+#include <stdexcept>
+#include <vector>
+
+// Include header file for MPI
+#include <mpi.h>
+
+// Include header file for the Gauss rule
+#include "GaussRule.hpp"
+
+using namespace std;
+
+// MPI data type of the C++ type T
+template<typename T>
+struct MPITypeTraits;
+
+template<>
+struct MPITypeTraits<float>{
+  static MPI_Datatype type(){ return MPI_FLOAT; }
+};
+
+template<>
+struct MPITypeTraits<double>{
+  static MPI_Datatype type(){ return MPI_DOUBLE; }
+};
+
+template<>
+struct MPITypeTraits<long double>{
+  static MPI_Datatype type(){ return MPI_LONG_DOUBLE; }
+};
+
+// Rank and number of processes of a communicator
+inline int mpi_rank(MPI_Comm comm){ int r; MPI_Comm_rank(comm, &r); return r; }
+inline int mpi_size(MPI_Comm comm){ int s; MPI_Comm_size(comm, &s); return s; }
+
+// First panel of rank r if p panels are split into s contiguous ranges
+inline long mpi_first(long p, int r, int s){ return long(r)*p/long(s); }
+
+// Evaluate the integral of f over [a,b] by the composite rule on p
+// panels, distributed over the ranks of comm. All ranks must call this
+// function (collectively) and obtain the result.
+template<typename TData, typename TIndex, typename TFunc>
+TData mpi_composite(MPI_Comm comm, GaussRule<TData,TIndex>& rule, TFunc f,
+                    TData a, TData b, long p){
+  if (p < 1)
+    throw invalid_argument("Number of panels must be positive.");
+
+  const int r = mpi_rank(comm), s = mpi_size(comm);
+  const TData H = (b-a)/TData(p);
+
+  TData local = TData(0);
+  for (long i=mpi_first(p, r, s); i<mpi_first(p, r+1, s); i++)
+    local += rule.eval(f, a + TData(i)*H, a + TData(i+1)*H);
+
+  TData global = TData(0);
+  MPI_Allreduce(&local, &global, 1, MPITypeTraits<TData>::type(), MPI_SUM, comm);
+  return global;
+}
+
+// Evaluate m independent integrals: result[i] = int_a[i]^b[i] f(i,x) dx
+// by the given rule. Job i is evaluated on rank i mod size; the other
+// ranks contribute zero, so that the sum over all ranks (computed by
+// MPI_Allreduce) is exact and every rank obtains all m results.
+template<typename TData, typename TIndex, typename TFunc>
+void mpi_sweep(MPI_Comm comm, GaussRule<TData,TIndex>& rule, TFunc f,
+               const TData* a, const TData* b, TData* result, long m){
+  if (m < 0 || m > long(INT_MAX))
+    throw invalid_argument("Number of jobs must fit into an MPI count.");
+
+  const int r = mpi_rank(comm), s = mpi_size(comm);
+
+  vector<TData> local(size_t(m), TData(0));
+  for (long i=r; i<m; i+=s)
+    local[size_t(i)] = rule.eval([&f, i](TData x){ return f(i, x); }, a[i], b[i]);
+
+  MPI_Allreduce(local.data(), result, int(m), MPITypeTraits<TData>::type(), MPI_SUM, comm);
+}
+
+#endif // MPI_INTEGRATION_HPP
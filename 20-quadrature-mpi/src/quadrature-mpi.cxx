@@ -0,0 +1,147 @@
+/**
+ * \file quadrature-mpi.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we distribute a composite integral and a parameter
+ * sweep over the processes of an MPI program, e.g.,
+ *
+ *   mpirun -np 8 ./quadrature-mpi
+ *
+ * Rank 0 first evaluates both problems alone (on MPI_COMM_SELF) as
+ * the serial reference; then all ranks evaluate them together. Running
+ * the program with -np 1, 2, 4, 8 gives the strong scaling.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header files for standard utility library and containers
+#include <cstdlib>
+#include <vector>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for function objects, the Gauss rule and the
+// MPI drivers
+#include "FunctionBase.hpp"
+#include "GaussRule.hpp"
+#include "MPIIntegration.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// Function object as in 07-quadrature-oop2-templates
+class Function1 : public FunctionBase<DataType>{
+public:
+  DataType operator()(DataType x){
+    return exp(cos(x));
+  }
+};
+
+// Integrand of job i of the sweep: sum_{j=1}^{10} cos(j*omega*x)/j
+// with omega depending on i
+DataType sweep_integrand(long i, DataType x){
+  const DataType omega = 1.0 + DataType(i % 100)/10.0;
+  DataType s = 0.0;
+  for (int j=1; j<=10; j++)
+    s += cos(j*omega*x)/j;
+  return s;
+}
+
+// Time of f() in seconds on the ranks of comm; the ranks start
+// together and the slowest one determines the time
+template<typename TFunc>
+double timed(MPI_Comm comm, TFunc f){
+  MPI_Barrier(comm);
+  double t = MPI_Wtime();
+  f();
+  t = MPI_Wtime() - t;
+  double tmax;
+  MPI_Allreduce(&t, &tmax, 1, MPI_DOUBLE, MPI_MAX, comm);
+  return tmax;
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Initialize MPI; it may remove its own arguments from argv
+  MPI_Init(&argc, &argv);
+  const int rank = mpi_rank(MPI_COMM_WORLD), size = mpi_size(MPI_COMM_WORLD);
+
+  // Get number of panels and jobs from command line arguments
+  long panels = 1000000, jobs = 20000;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 3:
+    panels = atol(argv[1]);
+    jobs   = atol(argv[2]);
+    break;
+  default:
+    if (rank == 0){
+      cout << "Usage: mpirun -np <ranks> quadrature-mpi" << endl;
+      cout << "       mpirun -np <ranks> quadrature-mpi panels jobs" << endl;
+    }
+    MPI_Finalize();
+    exit(-1);
+  }
+
+  GaussRule<DataType,IndexType> GR(7);
+  Function1 F1;
+  const DataType a = 0.0, b = 2.0*M_PI, exact = 2.0*M_PI*1.266065877752008335598244625;
+
+  vector<DataType> A(jobs, 0.0), B(jobs, 1.0), serial(jobs), result(jobs);
+  DataType IntRef = 0.0, Int = 0.0;
+  double tref_c = 0.0, tref_s = 0.0;
+
+  // Serial reference on rank 0
+  if (rank == 0){
+    tref_c = timed(MPI_COMM_SELF, [&](){
+        IntRef = mpi_composite(MPI_COMM_SELF, GR, ref(F1), a, b, panels);
+      });
+    tref_s = timed(MPI_COMM_SELF, [&](){
+        mpi_sweep(MPI_COMM_SELF, GR, sweep_integrand, A.data(), B.data(), serial.data(), jobs);
+      });
+  }
+
+  // All ranks together
+  double tc = timed(MPI_COMM_WORLD, [&](){
+      Int = mpi_composite(MPI_COMM_WORLD, GR, ref(F1), a, b, panels);
+    });
+  double ts = timed(MPI_COMM_WORLD, [&](){
+      mpi_sweep(MPI_COMM_WORLD, GR, sweep_integrand, A.data(), B.data(), result.data(), jobs);
+    });
+
+  if (rank == 0){
+    long mismatches = 0;
+    for (long i=0; i<jobs; i++)
+      mismatches += (result[i] != serial[i]);
+
+    cout.precision(15);
+    cout << "Ranks: " << size << endl;
+    cout << "Composite 7-pt Gauss, exp(cos(x)) on " << panels << " panels: " << Int
+         << " (error " << abs(Int-exact) << ", serial " << IntRef << ")" << endl;
+    cout << "Sweep of " << jobs << " integrals: " << mismatches << " mismatches" << endl;
+    cout.precision(6);
+    cout << "  composite: serial " << tref_c << " s, " << size << " ranks " << tc
+         << " s, speedup " << tref_c/tc << ", efficiency " << tref_c/tc/size << endl;
+    cout << "  sweep:     serial " << tref_s << " s, " << size << " ranks " << ts
+         << " s, speedup " << tref_s/ts << ", efficiency " << tref_s/ts/size << endl;
+  }
+
+  // End program
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,199 @@
+/**
+ * \file LowDiscrepancy.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements two low-discrepancy sequences in the unit cube
+ * [0,1)^d for quasi-Monte Carlo integration:
+ *
+ * - the Halton sequence: coordinate j of point i is the radical
+ *   inverse of i in the j-th prime base, for up to 32 dimensions,
+ *
+ * - the Sobol sequence: a digital sequence in base 2 with the direction
+ *   numbers of Joe and Kuo (new-joe-kuo-6.21201), for up to 21
+ *   dimensions, generated in Gray code order.
+ *
+ * Both generate a block of m consecutive points at once, starting at
+ * any index, which allows to split the points over threads. The points
+ * are stored dimension by dimension (X[j*m+i] is coordinate j of point
+ * i), so that integrands can loop over the points of one coordinate.
+ *
+ * For randomized QMC the points are randomized by a random shift per
+ * dimension: a random digital shift (xor) for Sobol, which preserves
+ * its net structure, and a random rotation modulo 1 (Cranley and
+ * Patterson) for Halton. Each randomization gives an unbiased
+ * estimate of the integral; the spread of several independent ones
+ * gives an error estimate.
+ *
+ */
+
+#ifndef LOW_DISCREPANCY_HPP
+#define LOW_DISCREPANCY_HPP
+
+// Include header files for fixed-width integer types and exceptions
+#include <cstdint>
+#include <stdexcept>
+
+// Include header file for containers
+#include <vector>
+
+using namespace std;
+
+// Position of the lowest zero bit of i, i.e., the number of trailing
+// ones; GCC and Clang count the trailing zeros of ~i in one instruction
+inline int lowest_zero_bit(uint64_t i){
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(~i);
+#else
+  int k = 0;
+  while (i & 1){
+    i >>= 1;
+    k++;
+  }
+  return k;
+#endif
+}
+
+class HaltonSequence{
+
+private:
+  int d;
+
+public:
+  // Largest supported dimension
+  static const int max_dim = 32;
+
+  // Constructor
+  explicit HaltonSequence(int d) : d(d){
+    if (d < 1 || d > max_dim)
+      throw invalid_argument("Halton sequence supports 1 to 32 dimensions.");
+  }
+
+  int dim() const { return d; }
+  static const char* name(){ return "Halton"; }
+
+  // Points first,...,first+m-1 in X (dimension by dimension). If shift
+  // is given, coordinate j is rotated by shift[j]/2^64 modulo 1.
+  void points(uint64_t first, long m, const uint64_t* shift, double* X) const {
+    static const int primes[max_dim] = {  2,   3,   5,   7,  11,  13,  17,  19,
+                                         23,  29,  31,  37,  41,  43,  47,  53,
+                                         59,  61,  67,  71,  73,  79,  83,  89,
+                                         97, 101, 103, 107, 109, 113, 127, 131};
+    for (int j=0; j<d; j++){
+      const uint64_t b = uint64_t(primes[j]);
+      const double   inv = 1.0/double(b);
+      const double   s = shift ? double(shift[j] >> 11) * 0x1.0p-53 : 0.0;
+      for (long i=0; i<m; i++){
+        // Radical inverse of the index
+        uint64_t k = first + uint64_t(i);
+        double x = 0.0, f = inv;
+        while (k > 0){
+          x += f*double(k % b);
+          k /= b;
+          f *= inv;
+        }
+        x += s;
+        X[j*m+i] = x < 1.0 ? x : x - 1.0;
+      }
+    }
+  }
+};
+
+class SobolSequence{
+
+private:
+  int d;
+
+  // Direction numbers v[j][k] for dimension j and bit k, scaled to 32
+  // bits
+  vector<uint32_t> v;
+
+public:
+  // Largest supported dimension
+  static const int max_dim = 21;
+
+  // Constructor: compute the direction numbers from the primitive
+  // polynomials and the initial numbers m_k
+  explicit SobolSequence(int d) : d(d), v(size_t(d)*32){
+    if (d < 1 || d > max_dim)
+      throw invalid_argument("Sobol sequence supports 1 to 21 dimensions.");
+
+    // Degree s, coefficients a and initial numbers m_1,...,m_s of
+    // dimensions 2,...,21
+    static const int s[max_dim-1] = {1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 7, 7};
+    static const int a[max_dim-1] = {0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1, 13, 16, 19, 22, 25, 1, 4};
+    static const int m[max_dim-1][7] = {{1},
+                                        {1, 3},
+                                        {1, 3, 1},
+                                        {1, 1, 1},
+                                        {1, 1, 3, 3},
+                                        {1, 3, 5, 13},
+                                        {1, 1, 5, 5, 17},
+                                        {1, 1, 5, 5, 5},
+                                        {1, 1, 7, 11, 19},
+                                        {1, 1, 5, 1, 1},
+                                        {1, 1, 1, 3, 11},
+                                        {1, 3, 5, 5, 31},
+                                        {1, 3, 3, 9, 7, 49},
+                                        {1, 1, 1, 15, 21, 21},
+                                        {1, 3, 1, 13, 27, 49},
+                                        {1, 1, 1, 15, 7, 5},
+                                        {1, 3, 1, 15, 13, 25},
+                                        {1, 1, 5, 5, 19, 61},
+                                        {1, 3, 7, 11, 23, 15, 103},
+                                        {1, 3, 7, 13, 13, 15, 69}};
+
+    // Dimension 1: van der Corput sequence
+    for (int k=0; k<32; k++)
+      v[k] = uint32_t(1) << (31-k);
+
+    for (int j=1; j<d; j++){
+      uint32_t* V = &v[size_t(j)*32];
+      const int S = s[j-1];
+      for (int k=0; k<S; k++)
+        V[k] = uint32_t(m[j-1][k]) << (31-k);
+      for (int k=S; k<32; k++){
+        V[k] = V[k-S] ^ (V[k-S] >> S);
+        for (int l=1; l<S; l++)
+          if ((a[j-1] >> (S-1-l)) & 1)
+            V[k] ^= V[k-l];
+      }
+    }
+  }
+
+  int dim() const { return d; }
+  static const char* name(){ return "Sobol"; }
+
+  // Points first,...,first+m-1 of the sequence in Gray code order, in
+  // X (dimension by dimension). If shift is given, coordinate j is
+  // xored with the upper 32 bits of shift[j]. At most 2^32 points.
+  void points(uint64_t first, long m, const uint64_t* shift, double* X) const {
+    if (first + uint64_t(m) > (uint64_t(1) << 32))
+      throw invalid_argument("Sobol sequence supports at most 2^32 points.");
+
+    for (int j=0; j<d; j++){
+      const uint32_t* V = &v[size_t(j)*32];
+
+      // Point with index first directly from the bits of its Gray code
+      uint32_t x = shift ? uint32_t(shift[j] >> 32) : 0u;
+      const uint64_t g = first ^ (first >> 1);
+      for (int k=0; k<32; k++)
+        if ((g >> k) & 1)
+          x ^= V[k];
+
+      // The following points differ by one direction number each: the
+      // one of the lowest zero bit of the index of the previous point.
+      // The points are moved to the centres of the cells of width
+      // 2^-32, so that no coordinate is exactly 0.
+      for (long i=0; i<m; i++){
+        X[j*m+i] = (double(x) + 0.5) * 0x1.0p-32;
+        if (i+1 < m)
+          x ^= V[lowest_zero_bit(first + uint64_t(i))];
+      }
+    }
+  }
+};
+
+#endif // LOW_DISCREPANCY_HPP
@@ -0,0 +1,159 @@
+/**
+ * \file MonteCarlo.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements Monte Carlo (MC) and randomized quasi-Monte
+ * Carlo (RQMC) integration over the unit cube [0,1)^d. The cost of
+ * tensor-product Gauss rules grows like n^d, whereas the error of MC
+ * decreases like N^(-1/2) and that of QMC almost like N^(-1) for
+ * smooth integrands in any dimension d.
+ *
+ * The points are generated in blocks and passed to a batch integrand
+ * f(const double* X, double* F, long m, int d), which evaluates the m
+ * points in X (dimension by dimension, see LowDiscrepancy.hpp) at
+ * once, e.g., with vectorized loops. The blocks are distributed over
+ * the workers of a thread pool; the sum of every block is stored and
+ * the block sums are added in a fixed order. Since every block of
+ * points only depends on its index and the seed, the result is the
+ * same for any number of threads.
+ *
+ * - mc_integrate uses Philox streams (one per coordinate) and
+ *   estimates the error from the sample variance,
+ *
+ * - rqmc_integrate averages R independently randomized copies of a
+ *   Halton or Sobol rule and estimates the error from their spread.
+ *
+ */
+
+#ifndef MONTE_CARLO_HPP
+#define MONTE_CARLO_HPP
+
+// Include header files for containers, futures and math functions
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+// Include header files for aligned arrays, the thread pool, the random
+// number generator and the low-discrepancy sequences
+#include "AlignedArray.hpp"
+#include "LowDiscrepancy.hpp"
+#include "Philox.hpp"
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+// Estimate of an integral, its standard error and the number of
+// integrand evaluations
+struct MCResult{
+  double value, error;
+  long   samples;
+};
+
+// Evaluate f on r=0,...,replicas-1 copies of n points in blocks of
+// size block. points(r, first, m, X) generates the points
+// first,...,first+m-1 of copy r. The sum of f and of f^2 over block b
+// of copy r is stored in s1[r*nb+b] and s2[r*nb+b], nb the number of
+// blocks per copy.
+template<typename TBatch, typename TPoints>
+void sample_blocks(ThreadPool& pool, const TBatch& f, const TPoints& points, int d, long n,
+                   long block, long replicas, vector<double>& s1, vector<double>& s2){
+  if (n < 1 || block < 1 || replicas < 1)
+    throw invalid_argument("Numbers of points, block size and replicas must be positive.");
+
+  const long nb = (n+block-1)/block, total = replicas*nb;
+  const long T = min(long(pool.size()), total);
+  s1.assign(size_t(total), 0.0);
+  s2.assign(size_t(total), 0.0);
+
+  vector<future<void> > done;
+  for (long t=0; t<T; t++)
+    done.push_back(pool.submit([&, t](){
+          AlignedArray<double> X(static_cast<size_t>(d)*static_cast<size_t>(block));
+          AlignedArray<double> F(static_cast<size_t>(block));
+          for (long k=t; k<total; k+=T){
+            const long r = k/nb, first = (k%nb)*block, m = min(block, n-first);
+            points(r, uint64_t(first), m, X.data());
+            f(static_cast<const double*>(X.data()), F.data(), m, d);
+            double a = 0.0, b = 0.0;
+            for (long i=0; i<m; i++){
+              a += F[i];
+              b += F[i]*F[i];
+            }
+            s1[size_t(k)] = a;
+            s2[size_t(k)] = b;
+          }
+        }));
+
+  for (auto& x : done)
+    x.wait();
+  for (auto& x : done)
+    x.get();
+}
+
+// Monte Carlo estimate of the integral of f over [0,1)^d with n points.
+// Coordinate j of point i is number i of the Philox stream j.
+template<typename TBatch>
+MCResult mc_integrate(ThreadPool& pool, const TBatch& f, int d, long n, uint64_t seed,
+                      long block=1024){
+  vector<PhiloxStream> streams;
+  for (int j=0; j<d; j++)
+    streams.push_back(PhiloxStream(seed, uint64_t(j)));
+
+  vector<double> s1, s2;
+  sample_blocks(pool, f, [&](long, uint64_t first, long m, double* X){
+      for (int j=0; j<d; j++)
+        streams[size_t(j)].uniform(first, m, X + j*m);
+    }, d, n, block, 1, s1, s2);
+
+  double a = 0.0, b = 0.0;
+  for (size_t k=0; k<s1.size(); k++){
+    a += s1[k];
+    b += s2[k];
+  }
+  const double mean = a/double(n);
+  const double var = n > 1 ? max(0.0, (b - double(n)*mean*mean)/double(n-1)) : 0.0;
+  return MCResult{mean, sqrt(var/double(n)), n};
+}
+
+// Randomized QMC estimate of the integral of f over [0,1)^d: the mean
+// of R randomizations of the first n points of the sequence (a
+// HaltonSequence or SobolSequence), with the standard error of the
+// mean as error estimate
+template<typename TBatch, typename TSequence>
+MCResult rqmc_integrate(ThreadPool& pool, const TBatch& f, const TSequence& seq, long n,
+                        uint64_t seed, long R=16, long block=1024){
+  if (R < 2)
+    throw invalid_argument("At least two randomizations are required.");
+
+  const int d = seq.dim();
+  vector<uint64_t> shifts(size_t(R)*size_t(d));
+  PhiloxStream(seed, uint64_t(1) << 32).fill(0, R*d, shifts.data());
+
+  vector<double> s1, s2;
+  sample_blocks(pool, f, [&](long r, uint64_t first, long m, double* X){
+      seq.points(first, m, &shifts[size_t(r)*size_t(d)], X);
+    }, d, n, block, R, s1, s2);
+
+  // Estimate of every randomization, then their mean and spread; the
+  // spread is small compared to the mean, so it is computed in a second
+  // pass to avoid cancellation
+  const long nb = (n+block-1)/block;
+  vector<double> q(size_t(R), 0.0);
+  double mean = 0.0;
+  for (long r=0; r<R; r++){
+    for (long b=0; b<nb; b++)
+      q[size_t(r)] += s1[size_t(r*nb+b)];
+    q[size_t(r)] /= double(n);
+    mean += q[size_t(r)]/double(R);
+  }
+  double var = 0.0;
+  for (long r=0; r<R; r++)
+    var += (q[size_t(r)]-mean)*(q[size_t(r)]-mean)/double(R-1);
+  return MCResult{mean, sqrt(var/double(R)), R*n};
+}
+
+#endif // MONTE_CARLO_HPP
@@ -0,0 +1,159 @@
+/**
+ * \file Philox.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the counter-based random number generator
+ * Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as
+ * 1, 2, 3", SC 2011). The n-th block of four 32-bit random numbers is
+ * a fixed function (ten rounds of multiplications and xors) of the
+ * counter n and a key, so that
+ *
+ * - there is no state to carry from one number to the next: any
+ *   position of the stream can be computed directly, and the loop
+ *   that fills an array with random numbers has independent
+ *   iterations which the compiler can vectorize,
+ *
+ * - every thread (or task, or process) can use a stream of its own by
+ *   putting its id into the counter, and the results are reproducible
+ *   independently of how the work is distributed.
+ *
+ */
+
+#ifndef PHILOX_HPP
+#define PHILOX_HPP
+
+// Include header file for fixed-width integer types
+#include <cstdint>
+
+using namespace std;
+
+// Counter and result of Philox4x32
+struct Philox4x32Block{
+  uint32_t v[4];
+};
+
+// Philox4x32-10 of counter c with key (k0,k1)
+inline Philox4x32Block philox4x32(Philox4x32Block c, uint32_t k0, uint32_t k1){
+  const uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+  const uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+  for (int round=0; round<10; round++){
+    const uint64_t p0 = uint64_t(M0)*c.v[0];
+    const uint64_t p1 = uint64_t(M1)*c.v[2];
+    Philox4x32Block d;
+    d.v[0] = uint32_t(p1 >> 32) ^ c.v[1] ^ k0;
+    d.v[1] = uint32_t(p1);
+    d.v[2] = uint32_t(p0 >> 32) ^ c.v[3] ^ k1;
+    d.v[3] = uint32_t(p0);
+    c = d;
+    k0 += W0;
+    k1 += W1;
+  }
+  return c;
+}
+
+// Philox4x32-10 of the L counters (v0[l],v1[l],v2[l],v3[l]) with key
+// (k0,k1), in place. Every round is a loop over the counters, i.e.,
+// over the elements of the four arrays, which the compiler vectorizes.
+inline void philox4x32(uint32_t* v0, uint32_t* v1, uint32_t* v2, uint32_t* v3, long L,
+                       uint32_t k0, uint32_t k1){
+  const uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+  const uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+  for (int round=0; round<10; round++){
+    for (long l=0; l<L; l++){
+      const uint64_t p0 = uint64_t(M0)*v0[l];
+      const uint64_t p1 = uint64_t(M1)*v2[l];
+      const uint32_t d0 = uint32_t(p1 >> 32) ^ v1[l] ^ k0;
+      const uint32_t d2 = uint32_t(p0 >> 32) ^ v3[l] ^ k1;
+      v0[l] = d0;
+      v1[l] = uint32_t(p1);
+      v2[l] = d2;
+      v3[l] = uint32_t(p0);
+    }
+    k0 += W0;
+    k1 += W1;
+  }
+}
+
+// Stream of random numbers for a seed and a stream id (e.g., the
+// number of a thread). Positions 2c and 2c+1 of the stream are the two
+// 64-bit halves of the block for counter (c, stream) and the seed as
+// key.
+class PhiloxStream{
+
+private:
+  uint64_t seed, stream;
+
+  // Number of blocks that are computed at once by uniform and fill
+  static constexpr long batch = 64;
+
+  // Block for counter c
+  Philox4x32Block block(uint64_t c) const {
+    const Philox4x32Block in = {{uint32_t(c), uint32_t(c >> 32),
+                                 uint32_t(stream), uint32_t(stream >> 32)}};
+    return philox4x32(in, uint32_t(seed), uint32_t(seed >> 32));
+  }
+
+  // Store conv(x) for the 64-bit random integers x at positions
+  // first,...,first+n-1 in out. Every block is computed once and gives
+  // two results; only an odd first position and an odd end take a
+  // single half. The blocks are computed in batches, stored as four
+  // arrays of 32-bit words, so that the rounds vectorize over the
+  // counters of a batch.
+  template<typename TOut, typename TConv>
+  void generate(uint64_t first, long n, TOut* out, TConv conv) const {
+    if (n <= 0)
+      return;
+    long k = 0;
+    if (first & 1)
+      out[k++] = conv(bits(first));
+    const uint64_t c0 = (first + uint64_t(k)) >> 1;
+    const long m = (n - k)/2;
+    TOut* o = out + k;
+    for (long j=0; j<m; j += batch){
+      const long L = m-j < batch ? m-j : batch;
+      uint32_t v0[batch], v1[batch], v2[batch], v3[batch];
+      for (long l=0; l<L; l++){
+        const uint64_t c = c0 + uint64_t(j+l);
+        v0[l] = uint32_t(c);
+        v1[l] = uint32_t(c >> 32);
+        v2[l] = uint32_t(stream);
+        v3[l] = uint32_t(stream >> 32);
+      }
+      philox4x32(v0, v1, v2, v3, L, uint32_t(seed), uint32_t(seed >> 32));
+      for (long l=0; l<L; l++){
+        o[2*(j+l)]   = conv(uint64_t(v1[l]) << 32 | v0[l]);
+        o[2*(j+l)+1] = conv(uint64_t(v3[l]) << 32 | v2[l]);
+      }
+    }
+    if (k + 2*m < n)
+      out[n-1] = conv(bits(first + uint64_t(n-1)));
+  }
+
+public:
+  // Constructor
+  explicit PhiloxStream(uint64_t seed=0, uint64_t stream=0) : seed(seed), stream(stream){}
+
+  // The 64-bit random integer at position i, for random access; for
+  // consecutive positions uniform and fill are much faster
+  uint64_t bits(uint64_t i) const {
+    const Philox4x32Block r = block(i >> 1);
+    return (i & 1) ? (uint64_t(r.v[3]) << 32 | r.v[2]) : (uint64_t(r.v[1]) << 32 | r.v[0]);
+  }
+
+  // Fill u with the n uniformly distributed numbers in [0,1) at
+  // positions first,...,first+n-1; the 53 upper bits of each 64-bit
+  // integer give the mantissa of a double
+  void uniform(uint64_t first, long n, double* u) const {
+    generate(first, n, u, [](uint64_t x){ return double(x >> 11) * 0x1.0p-53; });
+  }
+
+  // Same for 64-bit random integers
+  void fill(uint64_t first, long n, uint64_t* x) const {
+    generate(first, n, x, [](uint64_t x){ return x; });
+  }
+};
+
+#endif // PHILOX_HPP
@@ -0,0 +1,137 @@
+/**
+ * \file quadrature-montecarlo.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we integrate over the d-dimensional unit cube, where
+ * tensor-product Gauss rules are no longer affordable. We compare plain
+ * Monte Carlo with randomized Halton and Sobol points for the test
+ * function of Sobol
+ *
+ *   g(x) = prod_{j=1}^d (|4 x_j - 2| + a_j)/(1 + a_j),   a_j = j-1,
+ *
+ * whose integral is 1 for every d, and check that the result does not
+ * depend on the number of threads.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header files for standard utility library and containers
+#include <cstdlib>
+#include <string>
+
+// Include header file for math functions
+#include <cmath>
+
+// Include header files for the benchmark harness and the Monte Carlo
+// integrators
+#include "Benchmark.hpp"
+#include "MonteCarlo.hpp"
+
+using namespace std;
+
+// Batch integrand: g at the m points in X, stored dimension by
+// dimension. The loop over the points is innermost, so that it runs
+// over contiguous memory and can be vectorized.
+void sobol_g(const double* X, double* F, long m, int d){
+  for (long i=0; i<m; i++)
+    F[i] = 1.0;
+  for (int j=0; j<d; j++){
+    const double a = double(j);
+    const double* x = X + j*m;
+    for (long i=0; i<m; i++)
+      F[i] *= (abs(4.0*x[i]-2.0) + a)/(1.0 + a);
+  }
+}
+
+// Print an estimate with its estimated and actual error
+void print_result(const string& name, long n, const MCResult& r){
+  cout << left << setw(8) << name << right << setw(10) << n
+       << setw(22) << r.value << setw(14) << r.error << setw(14) << abs(r.value-1.0) << endl;
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get dimension and number of threads from command line arguments
+  int d = 10;
+  unsigned threads = thread::hardware_concurrency();
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    d = atoi(argv[1]);
+    break;
+  case 3:
+    d       = atoi(argv[1]);
+    threads = unsigned(atoi(argv[2]));
+    break;
+  default:
+    cout << "Usage: quadrature-montecarlo" << endl;
+    cout << "       quadrature-montecarlo dimension" << endl;
+    cout << "       quadrature-montecarlo dimension threads" << endl;
+    exit(-1);
+  }
+
+  ThreadPool pool(threads > 0 ? threads : 1), serial(1);
+  HaltonSequence halton(d);
+  SobolSequence  sobol(d);
+  const uint64_t seed = 2024;
+  const long     R = 16;
+
+  // Convergence: MC with N points, RQMC with R randomizations of N/R
+  // points each, i.e., the same number of integrand evaluations
+  cout << "Dimension " << d << ", " << pool.size() << " threads" << endl;
+  cout << left << setw(8) << "method" << right << setw(10) << "N"
+       << setw(22) << "estimate" << setw(14) << "est. error" << setw(14) << "error" << endl;
+  cout.precision(6);
+  for (int k=10; k<=20; k+=2){
+    const long N = 1L << k;
+    print_result("MC",     N, mc_integrate(pool, sobol_g, d, N, seed));
+    print_result("Halton", N, rqmc_integrate(pool, sobol_g, halton, N/R, seed, R));
+    print_result("Sobol",  N, rqmc_integrate(pool, sobol_g, sobol,  N/R, seed, R));
+  }
+
+  // Reproducibility: every block of points only depends on its index,
+  // so one thread gives bitwise the same result
+  const long N = 1L << 18;
+  const MCResult mc1 = mc_integrate(serial, sobol_g, d, N, seed);
+  const MCResult mcp = mc_integrate(pool,   sobol_g, d, N, seed);
+  const MCResult qs1 = rqmc_integrate(serial, sobol_g, sobol, N/R, seed, R);
+  const MCResult qsp = rqmc_integrate(pool,   sobol_g, sobol, N/R, seed, R);
+  cout << "Same result with 1 and " << pool.size() << " threads: MC "
+       << (mc1.value == mcp.value ? "yes" : "no") << ", Sobol "
+       << (qs1.value == qsp.value ? "yes" : "no") << endl;
+
+  // Cost of the point generation per coordinate
+  const long M = 4096;
+  AlignedArray<double> X(size_t(d)*size_t(M));
+  PhiloxStream stream(seed, 0);
+  print("Philox uniform", benchmark([&](){
+        stream.uniform(0, M, X.data());
+        do_not_optimize(X[0]);
+      }), double(M));
+  print("Halton point coordinate", benchmark([&](){
+        halton.points(0, M, nullptr, X.data());
+        do_not_optimize(X[0]);
+      }), double(M)*d);
+  print("Sobol point coordinate", benchmark([&](){
+        sobol.points(0, M, nullptr, X.data());
+        do_not_optimize(X[0]);
+      }), double(M)*d);
+  AlignedArray<double> F(static_cast<size_t>(M));
+  sobol.points(0, M, nullptr, X.data());
+  print("Integrand point coordinate", benchmark([&](){
+        sobol_g(X.data(), F.data(), M, d);
+        do_not_optimize(F[0]);
+      }), double(M)*d);
+
+  // End program
+  return 0;
+}
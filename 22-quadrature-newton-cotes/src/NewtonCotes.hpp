@@ -0,0 +1,177 @@
+/**
+ * \file NewtonCotes.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements Newton-Cotes quadrature rules with N equidistant
+ * points of any order. The weights are the integrals of the Lagrange
+ * polynomials of the points, which the compiler evaluates exactly with
+ * the constexpr Fraction class of H02-fraction. Only the final fractions
+ * are rounded to the floating-point type TData by Fraction::value, which
+ * divides the integers itself and rounds once, correctly, for float,
+ * double and long double with up to 64 significant bits (other types
+ * get the correctly rounded double). So the tables contain no rounding
+ * errors of a computation, need no setup at run time, and, e.g., the
+ * weights of Simpson's rule are the fractions 1/6, 4/6, 1/6 of
+ * 04-quadrature-static, correctly rounded.
+ *
+ * - closed rules use the points x_j = j/(N-1), j=0,...,N-1, of [0,1],
+ *   including both end points (trapezoidal rule for N=2, Simpson's rule
+ *   for N=3),
+ *
+ * - open rules use the points x_j = j/(N+1), j=1,...,N, excluding the
+ *   end points (midpoint rule for N=1), and can integrate functions
+ *   that are singular at the end points.
+ *
+ * The exact computation fits into 128-bit integers for up to N=24
+ * points (64-bit: N=14); for more points the compilation stops with an
+ * overflow error instead of producing inexact weights.
+ *
+ * Note that the weights of closed rules with N=9 and N>=11 points (and
+ * of open rules with N=3 and N>=5 points) are partly negative, so that high
+ * orders amplify rounding errors; composite rules of low order are the
+ * usual choice.
+ *
+ */
+
+#ifndef NEWTON_COTES_HPP
+#define NEWTON_COTES_HPP
+
+// Include header file for standard exception classes
+#include <stdexcept>
+
+// Include header file for exact fractions
+#include "Fraction.hpp"
+
+using namespace std;
+
+// Integer type of the exact computation: the widest available
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 NewtonCotesInt;
+#else
+typedef long long NewtonCotesInt;
+#endif
+
+// Points and weights of an N-point rule on [0,1]
+template<typename T, int N>
+struct NewtonCotesTable{
+  T x[N], w[N];
+};
+
+// Exact points and weights of the N-point closed or open Newton-Cotes
+// rule on [0,1]
+//
+// With q = N-1 (closed) or q = N+1 (open) the points are x_j = s_j/q
+// for the integers s_j. In the variable v = 2qx-q the points are the
+// integers v_j = 2s_j-q, symmetric about 0, and the weight of point k
+// is
+//
+//   w_k = 1/(2q) int_{-q}^{q} P_k(v) dv / P_k(v_k),
+//   P_k(v) = prod_{j!=k} (v-v_j),
+//
+// where the odd powers of P_k do not contribute to the integral.
+template<int N, bool Closed, typename TInt=NewtonCotesInt>
+constexpr NewtonCotesTable<Fraction<TInt>,N> newton_cotes_fractions(){
+  static_assert(N >= (Closed ? 2 : 1), "Closed rules need 2 points and open rules 1 point at least.");
+
+  const TInt q = Closed ? N-1 : N+1;
+  TInt v[N] = {};
+  for (int j=0; j<N; j++)
+    v[j] = 2*(Closed ? j : j+1) - q;
+
+  NewtonCotesTable<Fraction<TInt>,N> t = {};
+  for (int k=0; k<N; k++){
+    t.x[k] = Fraction<TInt>((v[k]+q)/2, q, true);
+
+    // Coefficients c[0],...,c[N-1] of P_k and the denominator P_k(v_k)
+    TInt c[N] = {};
+    TInt denom = 1;
+    int  degree = 0;
+    c[0] = 1;
+    for (int j=0; j<N; j++){
+      if (j == k)
+        continue;
+      // Multiply c by (v-v_j)
+      degree++;
+      for (int m=degree; m>0; m--)
+        c[m] = checked_add(c[m-1], checked_mul(-v[j], c[m]));
+      c[0] = checked_mul(-v[j], c[0]);
+      denom = checked_mul(denom, v[k]-v[j]);
+    }
+
+    // int_{-q}^{q} v^m dv = 2 q^(m+1)/(m+1) for even m
+    Fraction<TInt> integral = 0;
+    TInt qpow = q;
+    for (int m=0; m<=degree; m++){
+      if (m%2 == 0)
+        integral += Fraction<TInt>(checked_mul(checked_mul(TInt(2), qpow), c[m]), m+1, true);
+      if (m < degree)
+        qpow = checked_mul(qpow, q);
+    }
+    t.w[k] = integral / Fraction<TInt>(checked_mul(checked_mul(TInt(2), q), denom));
+  }
+  return t;
+}
+
+// Newton-Cotes rule with N points, for the floating-point type TData.
+// The tables are constant expressions, computed by the compiler.
+template<typename TData, int N, bool Closed=true>
+class NewtonCotesRule{
+
+private:
+  static constexpr NewtonCotesTable<TData,N> convert(){
+    NewtonCotesTable<TData,N> t = {};
+    const NewtonCotesTable<Fraction<NewtonCotesInt>,N> e = newton_cotes_fractions<N,Closed>();
+    for (int k=0; k<N; k++){
+      t.x[k] = e.x[k].template value<TData>();
+      t.w[k] = e.w[k].template value<TData>();
+    }
+    return t;
+  }
+
+public:
+  // Points and weights on [0,1]
+  static constexpr NewtonCotesTable<TData,N> table = convert();
+
+  static constexpr int size(){ return N; }
+  static constexpr bool closed(){ return Closed; }
+
+  // Integral of f over [a,b]
+  template<typename TFunc>
+  static TData eval(TFunc f, TData a, TData b){
+    const TData h = b-a;
+    TData s = TData(0);
+    for (int k=0; k<N; k++)
+      s += table.w[k]*f(a + h*table.x[k]);
+    return h*s;
+  }
+
+  // Composite rule on p panels of equal width. For closed rules the
+  // function value at a panel boundary is shared by both panels and
+  // evaluated only once (this is the composite Simpson's rule of
+  // 04-quadrature-static for N=3 with one evaluation less per panel).
+  template<typename TFunc>
+  static TData eval(TFunc f, TData a, TData b, long p){
+    if (p < 1)
+      throw invalid_argument("Number of panels must be positive.");
+
+    const TData H = (b-a)/TData(p);
+    TData s = TData(0);
+    for (long i=0; i<p; i++){
+      const TData c = a + TData(i)*H;
+      for (int k=Closed ? 1 : 0; k<(Closed ? N-1 : N); k++)
+        s += table.w[k]*f(c + H*table.x[k]);
+    }
+    if (Closed){
+      TData e = TData(0);
+      for (long i=1; i<p; i++)
+        e += f(a + TData(i)*H);
+      s += table.w[0]*(f(a) + f(b) + TData(2)*e);
+    }
+    return H*s;
+  }
+};
+
+#endif // NEWTON_COTES_HPP
@@ -0,0 +1,110 @@
+/**
+ * \file quadrature-newton-cotes.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we let the compiler compute the weights of
+ * Newton-Cotes rules of any order exactly, instead of typing them by
+ * hand as the weights 1/6, 4/6, 1/6 of Simpson's rule in
+ * 04-quadrature-static. We print the exact weights and compare the
+ * simple and composite rules for exp(x) over [0,1].
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+#include <iomanip>
+
+// Include header file for standard utility library
+#include <cstdlib>
+
+// Include header file for math functions
+#include <cmath>
+
+// Include header file for the Newton-Cotes rules
+#include "NewtonCotes.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+
+// The weights are computed at compile time: Simpson's rule is exact
+static_assert(newton_cotes_fractions<3,true>().w[0] == Fraction<NewtonCotesInt>(1, 6) &&
+              newton_cotes_fractions<3,true>().w[1] == Fraction<NewtonCotesInt>(4, 6) &&
+              newton_cotes_fractions<3,true>().w[2] == Fraction<NewtonCotesInt>(1, 6),
+              "Simpson's rule");
+static_assert(NewtonCotesRule<DataType,3>::table.w[1] == DataType(4)/DataType(6),
+              "Simpson's rule in double");
+
+// Print the exact weights of the N-point rule
+template<int N, bool Closed>
+void print_weights(){
+  constexpr auto t = newton_cotes_fractions<N,Closed>();
+  cout << setw(2) << N << (Closed ? " closed:" : " open:  ");
+  for (int k=0; k<(N+1)/2; k++)
+    cout << " " << (long long)t.w[k].n << "/" << (long long)t.w[k].d;
+  cout << endl;
+}
+
+// Print the errors of the simple and the composite N-point rule for
+// exp(x) over [0,1] with p panels
+template<int N, bool Closed>
+void print_errors(long p){
+  typedef NewtonCotesRule<DataType,N,Closed> Rule;
+  const DataType exact = exp(DataType(1)) - DataType(1);
+  auto f = [](DataType x){ return exp(x); };
+  cout << setw(2) << N << (Closed ? " closed" : " open  ")
+       << setw(14) << abs(Rule::eval(f, DataType(0), DataType(1)) - exact)
+       << setw(14) << abs(Rule::eval(f, DataType(0), DataType(1), p) - exact) << endl;
+}
+
+// Print the errors of the rules with N=First,...,Last points
+template<int First, int Last, bool Closed>
+void print_all(long p){
+  print_errors<First,Closed>(p);
+  if constexpr (First < Last)
+    print_all<First+1,Last,Closed>(p);
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of panels of the composite rules from command line
+  // arguments
+  long p = 10;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    p = atol(argv[1]);
+    break;
+  default:
+    cout << "Usage: quadrature-newton-cotes" << endl;
+    cout << "       quadrature-newton-cotes panels" << endl;
+    exit(-1);
+  }
+
+  cout << "Exact weights on [0,1] (first half, the rules are symmetric):" << endl;
+  print_weights<2,true>();
+  print_weights<3,true>();
+  print_weights<4,true>();
+  print_weights<5,true>();
+  print_weights<9,true>();
+  print_weights<1,false>();
+  print_weights<2,false>();
+  print_weights<3,false>();
+
+  cout << endl << "Errors for exp(x) over [0,1]: simple rule, composite rule on "
+       << p << " panels" << endl;
+  cout.precision(3);
+  print_all<2,12,true>(p);
+  print_all<1,8,false>(p);
+
+  // End program
+  return 0;
+}
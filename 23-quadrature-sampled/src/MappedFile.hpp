@@ -0,0 +1,122 @@
+/**
+ * \file MappedFile.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the integration of a binary file of uniformly
+ * spaced samples (raw values of type TData) that may be larger than
+ * the memory. The file is mapped into memory (POSIX mmap) one window
+ * at a time: the operating system reads the pages of the window on
+ * demand, the window is passed to UniformSums and unmapped again, so
+ * that at most one window of the file is resident in memory. Unlike
+ * reading with a stream there is no copy into a user buffer.
+ *
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+// Include header file for min and max
+#include <algorithm>
+
+// Include header files for exceptions and strings
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// Include header files for POSIX file and memory mapping functions
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Include header file for the integration of sampled data
+#include "SampledIntegration.hpp"
+
+using namespace std;
+
+// Read-only file of values of type T, mapped window by window
+template<typename T>
+class MappedFile{
+
+private:
+  int    fd;
+  size_t count;
+
+  static runtime_error error(const string& what, const string& path){
+    return runtime_error(what + " " + path + ": " + strerror(errno));
+  }
+
+public:
+  // Constructor: open the file; its size must be a multiple of sizeof(T)
+  explicit MappedFile(const string& path) : fd(::open(path.c_str(), O_RDONLY)), count(0){
+    if (fd < 0)
+      throw error("Cannot open", path);
+    struct stat st;
+    if (::fstat(fd, &st) != 0){
+      ::close(fd);
+      throw error("Cannot stat", path);
+    }
+    if (size_t(st.st_size) % sizeof(T) != 0){
+      ::close(fd);
+      throw invalid_argument("File size of " + path + " is not a multiple of the value size.");
+    }
+    count = size_t(st.st_size)/sizeof(T);
+  }
+
+  // Destructor
+  ~MappedFile(){ ::close(fd); }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Number of values in the file
+  size_t size() const { return count; }
+
+  // Call f(p, m) for consecutive windows of the file, where p points to
+  // m values. The windows have about window_bytes bytes, rounded to a
+  // multiple of both the page size and sizeof(T), so that every window
+  // starts at a page boundary (as required by mmap) and at a value.
+  template<typename TFunc>
+  void for_each_window(TFunc f, size_t window_bytes=size_t(1) << 24) const {
+    const size_t page = size_t(::sysconf(_SC_PAGESIZE));
+    size_t unit = page;
+    while (unit % sizeof(T) != 0)
+      unit += page;
+    const size_t window = max(unit, window_bytes/unit*unit);
+    const size_t bytes = count*sizeof(T);
+
+    for (size_t offset=0; offset<bytes; offset+=window){
+      const size_t len = min(window, bytes-offset);
+      void* p = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, off_t(offset));
+      if (p == MAP_FAILED)
+        throw runtime_error(string("Cannot map file window: ") + strerror(errno));
+
+      // The window is read once from the beginning to the end
+      ::madvise(p, len, MADV_SEQUENTIAL);
+      try {
+        f(static_cast<const T*>(p), len/sizeof(T));
+      } catch (...) {
+        ::munmap(p, len);
+        throw;
+      }
+      ::munmap(p, len);
+    }
+  }
+};
+
+// Sums of the uniformly spaced samples in the file path for the
+// trapezoidal and Simpson's rule (see UniformSums), computed window by
+// window
+template<typename TData>
+UniformSums<TData> sum_file(const string& path, size_t window_bytes=size_t(1) << 24){
+  MappedFile<TData> file(path);
+  UniformSums<TData> s;
+  file.for_each_window([&s](const TData* y, size_t m){ s.add(y, m); }, window_bytes);
+  return s;
+}
+
+#endif // MAPPED_FILE_HPP
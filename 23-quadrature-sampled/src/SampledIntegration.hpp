@@ -0,0 +1,269 @@
+/**
+ * \file SampledIntegration.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the integration of sampled data y_i = f(x_i),
+ * i=0,...,n-1, e.g., measurements, for which no function can be
+ * called at other points:
+ *
+ * - the trapezoidal rule, exact for piecewise linear data,
+ *
+ * - the composite Simpson's rule of 04-quadrature-static, generalized
+ *   to samples instead of a function: pairs of intervals are
+ *   integrated by the parabola through their three points; if the
+ *   number of intervals is odd, the last interval is integrated by the
+ *   parabola through the last three points,
+ *
+ * - the cubic spline with not-a-knot end conditions, which is exact
+ *   for cubic polynomials and uses all samples,
+ *
+ * for uniform (spacing h) and non-uniform (nodes x_i) samples.
+ *
+ * For uniform samples both rules are weighted sums of the samples, in
+ * which all samples with even index (and all with odd index) have the
+ * same weight, except for the first and the last ones. UniformSums
+ * therefore accumulates the sums of the samples with even and odd
+ * index (by a loop over blocks of SIMD width with one partial sum per
+ * lane, see 14-quadrature-aligned) and keeps the first and last three
+ * samples. Since the index is counted across calls of add, the data
+ * can be passed in chunks, e.g., of a file that does not fit into
+ * memory (see MappedFile.hpp).
+ *
+ */
+
+#ifndef SAMPLED_INTEGRATION_HPP
+#define SAMPLED_INTEGRATION_HPP
+
+// Include header files for exceptions and containers
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// Include header file for aligned and padded arrays (for the number of
+// SIMD lanes)
+#include "AlignedArray.hpp"
+
+using namespace std;
+
+// Accumulator of uniformly spaced samples that are passed in chunks
+template<typename TData>
+class UniformSums{
+
+private:
+  // Number of samples so far
+  size_t n;
+
+  // Sums of the samples with even and odd index
+  TData even, odd;
+
+  // First sample and last three samples (last[2] is the latest)
+  TData first, last[3];
+
+public:
+  // Number of lanes of a SIMD register; even, so that lane j always
+  // holds samples of the same parity
+  static constexpr size_t lanes = AlignedArray<TData>::lanes < 2 ? 2 : AlignedArray<TData>::lanes;
+
+  // Constructor
+  UniformSums() : n(0), even(TData(0)), odd(TData(0)), first(TData(0)), last{}{}
+
+  size_t size() const { return n; }
+
+  // Add the m samples y[0],...,y[m-1], which follow the previous ones
+  void add(const TData* y, size_t m){
+    if (m == 0)
+      return;
+    if (n == 0)
+      first = y[0];
+
+    // Lane j sums the samples with index n+j modulo 2
+    TData sum[lanes] = {};
+    size_t k = 0;
+    for (; k+lanes<=m; k+=lanes)
+      for (size_t j=0; j<lanes; j++)
+        sum[j] += y[k+j];
+    for (size_t j=0; k+j<m; j++)
+      sum[j] += y[k+j];
+
+    TData s0 = TData(0), s1 = TData(0);
+    for (size_t j=0; j<lanes; j+=2){
+      s0 += sum[j];
+      s1 += sum[j+1];
+    }
+    if (n%2 == 0){
+      even += s0;
+      odd  += s1;
+    } else {
+      even += s1;
+      odd  += s0;
+    }
+
+    // Shift the last three samples
+    for (size_t j=(m < 3 ? 0 : m-3); j<m; j++){
+      last[0] = last[1];
+      last[1] = last[2];
+      last[2] = y[j];
+    }
+    n += m;
+  }
+
+  // Trapezoidal rule with spacing h
+  TData trapezoid(TData h) const {
+    if (n < 2)
+      throw invalid_argument("The trapezoidal rule needs at least 2 samples.");
+    return h*(even + odd - (first + last[2])/TData(2));
+  }
+
+  // Composite Simpson's rule with spacing h
+  TData simpson(TData h) const {
+    if (n < 3)
+      return trapezoid(h);
+    if (n%2 == 1)
+      // Weights h/3*(1,4,2,4,...,2,4,1): the last index n-1 is even
+      return h/TData(3)*(TData(2)*even + TData(4)*odd - first - last[2]);
+
+    // Simpson's rule up to sample n-2 (the last sample with even index)
+    // and the parabola through the last three samples on the last
+    // interval
+    return h/TData(3)*(TData(2)*even + TData(4)*(odd - last[2]) - first - last[1])
+      + h/TData(12)*(TData(5)*last[2] + TData(8)*last[1] - last[0]);
+  }
+};
+
+// Trapezoidal rule for n samples with spacing h
+template<typename TData>
+TData trapezoid(const TData* y, size_t n, TData h){
+  UniformSums<TData> s;
+  s.add(y, n);
+  return s.trapezoid(h);
+}
+
+// Composite Simpson's rule for n samples with spacing h
+template<typename TData>
+TData simpson(const TData* y, size_t n, TData h){
+  UniformSums<TData> s;
+  s.add(y, n);
+  return s.simpson(h);
+}
+
+// Trapezoidal rule for n samples at the increasing nodes x
+template<typename TData>
+TData trapezoid(const TData* x, const TData* y, size_t n){
+  if (n < 2)
+    throw invalid_argument("The trapezoidal rule needs at least 2 samples.");
+
+  // One partial sum per lane, as in UniformSums
+  const size_t L = AlignedArray<TData>::lanes;
+  TData sum[AlignedArray<TData>::lanes] = {};
+  size_t k = 0;
+  for (; k+L<n; k+=L)
+    for (size_t j=0; j<L; j++)
+      sum[j] += (x[k+j+1]-x[k+j])*(y[k+j]+y[k+j+1]);
+  for (size_t j=0; k+j+1<n; j++)
+    sum[j] += (x[k+j+1]-x[k+j])*(y[k+j]+y[k+j+1]);
+
+  TData Int = TData(0);
+  for (size_t j=0; j<L; j++)
+    Int += sum[j];
+  return Int/TData(2);
+}
+
+// Composite Simpson's rule for n samples at the increasing nodes x:
+// the parabola through x_{2k}, x_{2k+1}, x_{2k+2} with the spacings
+// h0 and h1 integrates to
+//
+//   (h0+h1)/6 * ((2-h1/h0) y_{2k} + (h0+h1)^2/(h0 h1) y_{2k+1} + (2-h0/h1) y_{2k+2})
+template<typename TData>
+TData simpson(const TData* x, const TData* y, size_t n){
+  if (n < 3)
+    return trapezoid(x, y, n);
+
+  // Number of intervals integrated in pairs
+  const size_t m = (n-1)/2*2;
+
+  TData Int = TData(0);
+  for (size_t k=0; k<m; k+=2){
+    const TData h0 = x[k+1]-x[k], h1 = x[k+2]-x[k+1];
+    Int += (h0+h1)/TData(6)*((TData(2)-h1/h0)*y[k]
+                             + (h0+h1)*(h0+h1)/(h0*h1)*y[k+1]
+                             + (TData(2)-h0/h1)*y[k+2]);
+  }
+
+  // Last interval by the parabola through the last three points
+  if (m < n-1){
+    const TData h0 = x[n-2]-x[n-3], h1 = x[n-1]-x[n-2];
+    Int += h1*(y[n-1]*(TData(2)*h1+TData(3)*h0)/(TData(6)*(h0+h1))
+               + y[n-2]*(h1+TData(3)*h0)/(TData(6)*h0)
+               - y[n-3]*h1*h1/(TData(6)*h0*(h0+h1)));
+  }
+  return Int;
+}
+
+// Integral of the cubic spline with not-a-knot end conditions through
+// n samples at the increasing nodes x. On interval i of width h_i the
+// spline integrates to
+//
+//   h_i (y_i + y_{i+1})/2 - h_i^3 (M_i + M_{i+1})/24,
+//
+// where the second derivatives M_i solve a tridiagonal system. The
+// not-a-knot conditions (the third derivative is continuous at x_1 and
+// x_{n-2}) eliminate M_0 and M_{n-1}.
+template<typename TData>
+TData spline(const TData* x, const TData* y, size_t n){
+  if (n < 4)
+    return simpson(x, y, n);
+
+  // Equation i=1,...,n-2 reads a M_{i-1} + b M_i + c M_{i+1} = r. It is
+  // set up on the fly and solved by the Thomas algorithm: the forward
+  // sweep stores the modified super-diagonal in cp and right-hand side
+  // in M, the backward sweep overwrites M by the solution.
+  vector<TData> M(n, TData(0)), cp(n, TData(0));
+  for (size_t i=1; i+1<n; i++){
+    const TData h0 = x[i]-x[i-1], h1 = x[i+1]-x[i];
+    TData a = h0, b = TData(2)*(h0+h1), c = h1;
+    const TData r = TData(6)*((y[i+1]-y[i])/h1 - (y[i]-y[i-1])/h0);
+
+    // M_0 = ((h0+h1) M_1 - h0 M_2)/h1 in the first equation and the
+    // corresponding expression for M_{n-1} in the last one
+    if (i == 1){
+      b = (h0+h1)*(h0+TData(2)*h1)/h1;
+      c = (h1-h0)*(h1+h0)/h1;
+    }
+    if (i == n-2){
+      b = (h1+h0)*(h1+TData(2)*h0)/h0;
+      a = (h0-h1)*(h0+h1)/h0;
+    }
+
+    const TData inv = TData(1)/(b - a*cp[i-1]);
+    cp[i] = c*inv;
+    M[i]  = (r - a*M[i-1])*inv;
+  }
+  for (size_t i=n-3; i>0; i--)
+    M[i] -= cp[i]*M[i+1];
+
+  const TData h0 = x[1]-x[0], h1 = x[2]-x[1];
+  const TData g0 = x[n-1]-x[n-2], g1 = x[n-2]-x[n-3];
+  M[0]   = ((h0+h1)*M[1] - h0*M[2])/h1;
+  M[n-1] = ((g0+g1)*M[n-2] - g0*M[n-3])/g1;
+
+  TData Int = TData(0);
+  for (size_t i=0; i+1<n; i++){
+    const TData h = x[i+1]-x[i];
+    Int += h*(y[i]+y[i+1])/TData(2) - h*h*h*(M[i]+M[i+1])/TData(24);
+  }
+  return Int;
+}
+
+// Cubic spline for n samples with spacing h
+template<typename TData>
+TData spline(const TData* y, size_t n, TData h){
+  vector<TData> x(n);
+  for (size_t i=0; i<n; i++)
+    x[i] = TData(i)*h;
+  return spline(x.data(), y, n);
+}
+
+#endif // SAMPLED_INTEGRATION_HPP
@@ -0,0 +1,142 @@
+/**
+ * \file quadrature-sampled.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we integrate sampled data instead of a function:
+ * samples of sin(x) over [0,pi] on uniform and on non-uniform grids by
+ * the trapezoidal rule, Simpson's rule and the cubic spline. Finally,
+ * a large file of samples is integrated window by window through a
+ * memory mapping.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header files for standard utility library, containers,
+// files and random numbers
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for the benchmark harness, the integration of
+// sampled data and of mapped files
+#include "Benchmark.hpp"
+#include "MappedFile.hpp"
+#include "SampledIntegration.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+
+// Composite Simpson's rule on n-1 intervals (n odd) as the loop in
+// 04-quadrature-static, for comparison
+DataType simpson_loop(const DataType* y, size_t n, DataType h){
+  DataType Int = 0.0;
+  for (size_t k=0; k+2<n; k+=2)
+    Int += h/3.0 * (y[k] + 4.0*y[k+1] + y[k+2]);
+  return Int;
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of samples of the file from command line arguments
+  size_t samples = size_t(1) << 23;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    samples = size_t(atol(argv[1]));
+    break;
+  default:
+    cout << "Usage: quadrature-sampled" << endl;
+    cout << "       quadrature-sampled file-samples" << endl;
+    exit(-1);
+  }
+
+  const DataType a = 0.0, b = M_PI, exact = 2.0;
+  cout.precision(3);
+
+  // Uniform and randomly perturbed non-uniform grids
+  cout << "Errors for sin(x) over [0,pi]" << endl;
+  cout << setw(8) << "n" << setw(12) << "trapezoid" << setw(12) << "Simpson" << setw(12) << "spline"
+       << setw(14) << "trapezoid nu" << setw(12) << "Simpson nu" << setw(12) << "spline nu" << endl;
+  mt19937 gen(1);
+  uniform_real_distribution<DataType> jitter(-0.4, 0.4);
+  for (size_t n : {11, 12, 101, 102, 1001, 1002}){
+    const DataType h = (b-a)/DataType(n-1);
+    vector<DataType> x(n), y(n), xu(n), yu(n);
+    for (size_t i=0; i<n; i++){
+      xu[i] = a + DataType(i)*h;
+      yu[i] = sin(xu[i]);
+      x[i]  = (i == 0 || i == n-1) ? xu[i] : xu[i] + jitter(gen)*h;
+      y[i]  = sin(x[i]);
+    }
+    cout << setw(8) << n
+         << setw(12) << abs(trapezoid(yu.data(), n, h) - exact)
+         << setw(12) << abs(simpson(yu.data(), n, h) - exact)
+         << setw(12) << abs(spline(yu.data(), n, h) - exact)
+         << setw(14) << abs(trapezoid(x.data(), y.data(), n) - exact)
+         << setw(12) << abs(simpson(x.data(), y.data(), n) - exact)
+         << setw(12) << abs(spline(x.data(), y.data(), n) - exact) << endl;
+  }
+
+  // Throughput of the kernels in memory
+  const size_t n = (size_t(1) << 20) + 1;
+  const DataType h = (b-a)/DataType(n-1);
+  vector<DataType> x(n), y(n);
+  for (size_t i=0; i<n; i++){
+    x[i] = a + DataType(i)*h;
+    y[i] = sin(x[i]);
+  }
+  cout << endl << "Time per sample for " << n << " samples" << endl;
+  print("Simpson loop", benchmark([&](){ do_not_optimize(simpson_loop(y.data(), n, h)); }), double(n));
+  print("Simpson uniform", benchmark([&](){ do_not_optimize(simpson(y.data(), n, h)); }), double(n));
+  print("trapezoid uniform", benchmark([&](){ do_not_optimize(trapezoid(y.data(), n, h)); }), double(n));
+  print("Simpson non-uniform", benchmark([&](){ do_not_optimize(simpson(x.data(), y.data(), n)); }), double(n));
+  print("trapezoid non-uniform", benchmark([&](){ do_not_optimize(trapezoid(x.data(), y.data(), n)); }), double(n));
+  print("spline non-uniform", benchmark([&](){ do_not_optimize(spline(x.data(), y.data(), n)); }), double(n));
+
+  // Write samples to a file in blocks and integrate it window by window
+  const filesystem::path path = filesystem::temp_directory_path() / "quadrature-sampled.bin";
+  const DataType H = (b-a)/DataType(samples-1);
+  {
+    ofstream file(path, ios::binary);
+    vector<DataType> block(1 << 16);
+    for (size_t i=0; i<samples; i+=block.size()){
+      const size_t m = min(block.size(), samples-i);
+      for (size_t k=0; k<m; k++)
+        block[k] = sin(a + DataType(i+k)*H);
+      file.write(reinterpret_cast<const char*>(block.data()), streamsize(m*sizeof(DataType)));
+    }
+  }
+
+  auto start = chrono::steady_clock::now();
+  const UniformSums<DataType> s = sum_file<DataType>(path.string(), size_t(1) << 20);
+  const double t = chrono::duration<double>(chrono::steady_clock::now()-start).count();
+  filesystem::remove(path);
+
+  cout.precision(15);
+  cout << endl << "File of " << s.size() << " samples (" << s.size()*sizeof(DataType)/1048576
+       << " MiB) in windows of 1 MiB:" << endl;
+  cout << "  trapezoid " << s.trapezoid(H) << ", Simpson " << s.simpson(H) << endl;
+  cout.precision(3);
+  cout << "  " << t << " s, " << double(s.size()*sizeof(DataType))/t/1e9 << " GB/s" << endl;
+
+  // End program
+  return 0;
+}
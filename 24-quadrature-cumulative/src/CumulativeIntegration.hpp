@@ -0,0 +1,162 @@
+/**
+ * \file CumulativeIntegration.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements cumulative integration: the values
+ *
+ *   F_i = int_{x_0}^{x_i} f(x) dx,   i=0,...,p,
+ *
+ * of the antiderivative at all nodes x_0 < x_1 < ... < x_p of a grid.
+ * Evaluating every F_i by its own composite rule costs O(p^2) panel
+ * integrals. Instead, every panel [x_i,x_{i+1}] is integrated once by
+ * an n-point Gauss rule, and F is the prefix sum (scan) of the panel
+ * integrals, in O(p) work. Both steps run in parallel on a thread pool:
+ *
+ * 1. the panels are split into contiguous chunks, one task per chunk;
+ *    each task integrates its panels and computes the prefix sums
+ *    within its chunk, block by block while the block is in cache,
+ *
+ * 2. the totals of the chunks are scanned sequentially (there are
+ *    only a few of them), which gives the offset of every chunk,
+ *
+ * 3. each task adds the offset of its chunk to its prefix sums.
+ *
+ * Within a block the loop over the quadrature points is the outer and
+ * the loop over the panels the inner one, so that the compiler can
+ * vectorize the evaluation of f over the panels of a block.
+ *
+ */
+
+#ifndef CUMULATIVE_INTEGRATION_HPP
+#define CUMULATIVE_INTEGRATION_HPP
+
+// Include header files for containers, futures and exceptions
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+// Include header files for the Gauss rule, the thread pool and the
+// padded per-task accumulators
+#include "GaussRule.hpp"
+#include "ParallelReduction.hpp"
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+// Number of panels integrated together by the inner loops
+static const long cumulative_block = 256;
+
+// Integrate the panels first,...,last-1 between the nodes node(i) and
+// node(i+1) by the rule and store the prefix sums of their integrals,
+// starting from zero, in F[first+1],...,F[last]. Returns the sum of all
+// panels of the range.
+template<typename TData, typename TIndex, typename TFunc, typename TNodes>
+TData cumulative_range(const GaussRule<TData,TIndex>& rule, TFunc f, TNodes node,
+                       long first, long last, TData* F){
+  const TData* x = rule.half_points();
+  const TData* w = rule.half_weights();
+  const TIndex N = rule.size();
+
+  TData c[cumulative_block], h[cumulative_block], s[cumulative_block];
+  TData run = TData(0);
+  for (long i0=first; i0<last; i0+=cumulative_block){
+    const long m = min(cumulative_block, last-i0);
+
+    // Centres and half widths of the panels of the block
+    TData lo = node(i0);
+    for (long j=0; j<m; j++){
+      const TData hi = node(i0+j+1);
+      c[j] = (lo+hi)/TData(2);
+      h[j] = (hi-lo)/TData(2);
+      s[j] = TData(0);
+      lo = hi;
+    }
+
+    // Contributions of the points, as in GaussRule::eval
+    TIndex k = 0;
+    if (N % 2 == 1){
+      for (long j=0; j<m; j++)
+        s[j] = w[0]*f(c[j]);
+      k = 1;
+    }
+    for (; k<rule.half_size(); k++)
+      for (long j=0; j<m; j++){
+        const TData d = h[j]*x[k];
+        s[j] += w[k]*(f(c[j] + d) + f(c[j] - d));
+      }
+
+    // Prefix sums of the panel integrals
+    for (long j=0; j<m; j++){
+      run += h[j]*s[j];
+      F[i0+j+1] = run;
+    }
+  }
+  return run;
+}
+
+// Cumulative integral F_i = int_{node(0)}^{node(i)} f(x) dx, i=0,...,p,
+// by the composite n-point Gauss rule on the p panels between the
+// nodes, in parallel; F must hold p+1 values. The panels are split into
+// chunks_per_worker chunks per worker (see parallel_composite).
+template<typename TData, typename TIndex, typename TFunc, typename TNodes>
+void cumulative_integrate_nodes(ThreadPool& pool, TFunc f, TNodes node, TIndex n, long p, TData* F,
+                                unsigned chunks_per_worker=4){
+  if (p < 1)
+    throw invalid_argument("Number of panels must be positive.");
+
+  const long m = min(long(chunks_per_worker)*long(pool.size()), p);
+  PerTaskAccumulator<TData> total(static_cast<size_t>(m));
+  F[0] = TData(0);
+
+  // Step 1: integrals and prefix sums within the chunks
+  vector<future<void> > done;
+  done.reserve(size_t(m));
+  for (long t=0; t<m; t++)
+    done.push_back(pool.submit([&, t](){
+          const GaussRule<TData,TIndex> rule(n);
+          total[size_t(t)] = cumulative_range(rule, f, node, t*p/m, (t+1)*p/m, F);
+        }));
+  for (auto& d : done)
+    d.wait();
+  for (auto& d : done)
+    d.get();
+
+  // Step 2: offsets of the chunks (exclusive scan of their totals)
+  vector<TData> offset(size_t(m), TData(0));
+  for (long t=1; t<m; t++)
+    offset[size_t(t)] = offset[size_t(t-1)] + total[size_t(t-1)];
+
+  // Step 3: add the offsets; the first chunk has none
+  done.clear();
+  for (long t=1; t<m; t++)
+    done.push_back(pool.submit([&, t](){
+          const TData o = offset[size_t(t)];
+          for (long i=t*p/m+1; i<=(t+1)*p/m; i++)
+            F[i] += o;
+        }));
+  for (auto& d : done)
+    d.wait();
+  for (auto& d : done)
+    d.get();
+}
+
+// Cumulative integral at the p+1 nodes x[0],...,x[p]
+template<typename TData, typename TIndex, typename TFunc>
+void cumulative_integrate(ThreadPool& pool, TFunc f, const TData* x, TIndex n, long p, TData* F,
+                          unsigned chunks_per_worker=4){
+  cumulative_integrate_nodes(pool, f, [x](long i){ return x[i]; }, n, p, F, chunks_per_worker);
+}
+
+// Cumulative integral at the p+1 equidistant nodes a + i*(b-a)/p
+template<typename TData, typename TIndex, typename TFunc>
+void cumulative_integrate(ThreadPool& pool, TFunc f, TData a, TData b, TIndex n, long p, TData* F,
+                          unsigned chunks_per_worker=4){
+  const TData H = (b-a)/TData(p);
+  cumulative_integrate_nodes(pool, f, [a, H](long i){ return a + TData(i)*H; },
+                             n, p, F, chunks_per_worker);
+}
+
+#endif // CUMULATIVE_INTEGRATION_HPP
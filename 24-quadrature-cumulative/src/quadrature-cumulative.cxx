@@ -0,0 +1,121 @@
+/**
+ * \file quadrature-cumulative.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we compute the antiderivative F(x) = int_0^x cos(t) dt
+ * = sin(x) at all nodes of a fine grid, once by one composite rule per
+ * node (O(p^2) panels) and once by a parallel prefix sum of the panel
+ * integrals (O(p) panels).
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header files for standard utility library, clocks and
+// containers
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+// Include header file for math functions
+#include <cmath>
+
+// Include header file for cumulative integration
+#include "CumulativeIntegration.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// Time of f() in seconds
+template<typename TFunc>
+double timed(TFunc f){
+  auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now()-start).count();
+}
+
+// Largest error of F compared to sin at the nodes x
+DataType max_error(const vector<DataType>& x, const vector<DataType>& F){
+  DataType e = 0.0;
+  for (size_t i=0; i<x.size(); i++)
+    e = max(e, abs(F[i] - sin(x[i])));
+  return e;
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of panels and threads from command line arguments
+  long p = 10000000;
+  unsigned threads = thread::hardware_concurrency();
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    p = atol(argv[1]);
+    break;
+  case 3:
+    p       = atol(argv[1]);
+    threads = unsigned(atoi(argv[2]));
+    break;
+  default:
+    cout << "Usage: quadrature-cumulative" << endl;
+    cout << "       quadrature-cumulative panels" << endl;
+    cout << "       quadrature-cumulative panels threads" << endl;
+    exit(-1);
+  }
+
+  ThreadPool pool(threads > 0 ? threads : 1), serial(1);
+  const IndexType n = 4;
+  const DataType a = 0.0, b = 100.0;
+  auto f = [](DataType x){ return cos(x); };
+  cout.precision(3);
+
+  // One composite rule per node is quadratic in the number of panels
+  const long q = 4000;
+  vector<DataType> xq(q+1), Fq(q+1), Gq(q+1);
+  for (long i=0; i<=q; i++)
+    xq[i] = a + DataType(i)*(b-a)/DataType(q);
+  const double tq = timed([&](){
+      GaussRule<DataType,IndexType> rule(n);
+      const DataType H = (b-a)/DataType(q);
+      for (long i=0; i<=q; i++){
+        Fq[i] = 0.0;
+        for (long j=0; j<i; j++)
+          Fq[i] += rule.eval(f, a + DataType(j)*H, a + DataType(j+1)*H);
+      }
+    });
+  const double tc = timed([&](){ cumulative_integrate(serial, f, a, b, n, q, Gq.data()); });
+  cout << q << " panels: one composite rule per node " << tq << " s, prefix sum " << tc
+       << " s, errors " << max_error(xq, Fq) << " and " << max_error(xq, Gq) << endl;
+
+  // Uniform fine grid, one and several threads
+  vector<DataType> x(p+1), F(p+1);
+  for (long i=0; i<=p; i++)
+    x[i] = a + DataType(i)*(b-a)/DataType(p);
+  const double t1 = timed([&](){ cumulative_integrate(serial, f, a, b, n, p, F.data()); });
+  const double tp = timed([&](){ cumulative_integrate(pool, f, a, b, n, p, F.data()); });
+  cout << p << " panels, uniform:     1 thread " << t1 << " s, " << pool.size() << " threads "
+       << tp << " s, error " << max_error(x, F) << endl;
+
+  // Non-uniform grid refined towards a
+  for (long i=0; i<=p; i++){
+    const DataType s = DataType(i)/DataType(p);
+    x[i] = a + (b-a)*s*s;
+  }
+  const double tn = timed([&](){ cumulative_integrate(pool, f, x.data(), n, p, F.data()); });
+  cout << p << " panels, non-uniform: " << pool.size() << " threads " << tn
+       << " s, error " << max_error(x, F) << endl;
+
+  // End program
+  return 0;
+}
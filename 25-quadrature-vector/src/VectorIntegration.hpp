@@ -0,0 +1,177 @@
+/**
+ * \file VectorIntegration.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the integration of vector-valued functions
+ * f = (f_0,...,f_{m-1}), e.g., the moments int x^k g(x) dx of one
+ * function g, with one evaluation of f per quadrature point for all
+ * components, instead of one integration (and evaluation of g) per
+ * component:
+ *
+ * - VectorFunctionBase is the vector-valued counterpart of FunctionBase
+ *   of 07-quadrature-oop2-templates: the virtual ()-operator writes the
+ *   M components at x into an array of M values (a span),
+ *
+ * - integrate_components and integrate_vector do the same for any
+ *   callable that writes M components into an array or returns a
+ *   std::array<TData,M>,
+ *
+ * - integrate_batch evaluates a composite rule with a batch integrand
+ *   f(x, np, Y) that computes the m components at np points at once
+ *   and stores them component by component, Y[c*np+j] = f_c(x_j)
+ *   (structure of arrays). The accumulator has the same layout: one
+ *   partial sum per SIMD lane and component, acc[c*L+l], so that the
+ *   loops over the points of a component run over contiguous memory
+ *   and are vectorized (see 14-quadrature-aligned).
+ *
+ */
+
+#ifndef VECTOR_INTEGRATION_HPP
+#define VECTOR_INTEGRATION_HPP
+
+// Include header files for arrays, type traits and exceptions
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+
+// Include header files for the Gauss rule and aligned arrays
+#include "AlignedArray.hpp"
+#include "GaussRule.hpp"
+
+using namespace std;
+
+// Integral of the M components of f over [a,b] by the rule, where
+// f(x, y) writes the components at x into y[0],...,y[M-1]. The
+// structure follows GaussRule::eval.
+template<int M, typename TData, typename TIndex, typename TFunc>
+array<TData,M> integrate_components(const GaussRule<TData,TIndex>& rule, TFunc f, TData a, TData b){
+  const TData* x = rule.half_points();
+  const TData* w = rule.half_weights();
+  const TData h = (b-a)/TData(2);
+  const TData c = (a+b)/TData(2);
+
+  array<TData,M> Int;
+  TData y1[M], y2[M];
+  for (int m=0; m<M; m++)
+    Int[m] = TData(0);
+
+  TIndex k = 0;
+  if (rule.size() % 2 == 1){
+    f(c, y1);
+    for (int m=0; m<M; m++)
+      Int[m] = w[0]*y1[m];
+    k = 1;
+  }
+  for (; k<rule.half_size(); k++){
+    const TData d = h * x[k];
+    f(c + d, y1);
+    f(c - d, y2);
+    for (int m=0; m<M; m++)
+      Int[m] += w[k]*(y1[m] + y2[m]);
+  }
+  for (int m=0; m<M; m++)
+    Int[m] *= h;
+  return Int;
+}
+
+// Integral of f over [a,b], where f(x) returns a std::array<TData,M>
+template<typename TData, typename TIndex, typename TFunc>
+auto integrate_vector(const GaussRule<TData,TIndex>& rule, TFunc f, TData a, TData b)
+  -> decltype(f(a)){
+  typedef decltype(f(a)) TResult;
+  const int M = int(tuple_size<TResult>::value);
+  return integrate_components<M>(rule, [&f](TData x, TData* y){
+      const TResult v = f(x);
+      for (int m=0; m<M; m++)
+        y[m] = v[m];
+    }, a, b);
+}
+
+// Templated abstract class of functions with M components
+template<typename TData=double, int M=1>
+class VectorFunctionBase{
+
+public:
+  // Number of components
+  static constexpr int components(){ return M; }
+
+  // The ()-operator writes the M components at x into y[0],...,y[M-1]
+  virtual void operator()(TData x, TData* y) = 0;
+
+  // Integrate all components over [a,b] by the n-point Gauss rule in
+  // one pass over the points
+  template<typename TIndex=int>
+  array<TData,M> integrate(TData a, TData b, TIndex n=3){
+    const GaussRule<TData,TIndex> rule(n);
+    return integrate_components<M>(rule, [this](TData x, TData* y){ (*this)(x, y); }, a, b);
+  }
+};
+
+// Integrals result[0],...,result[m-1] of the m components of f over
+// [a,b] by the composite rule on p panels. The batch integrand
+// f(x, np, Y) sets Y[c*np+j] to component c at the point x[j] for
+// j=0,...,np-1; np is a multiple of the number of lanes, and points
+// beyond the last panel of a block repeat a point of the block and have
+// weight zero.
+template<typename TData, typename TIndex, typename TBatch>
+void integrate_batch(const GaussRule<TData,TIndex>& rule, TBatch f, TData a, TData b, long p,
+                     int m, TData* result){
+  if (p < 1 || m < 1)
+    throw invalid_argument("Numbers of panels and components must be positive.");
+
+  const size_t L = AlignedArray<TData>::lanes;
+  const TIndex N = rule.size();
+  const TData* xr = rule.half_points();
+  const TData* wr = rule.half_weights();
+  const TData H = (b-a)/TData(p), h = H/TData(2);
+
+  // Panels per block, so that a block has about 256 points
+  const long B = max(1L, 256L/long(N));
+  const size_t np = AlignedArray<TData>::padded(size_t(B)*size_t(N));
+
+  // Points and weights of a block, the components at the points and
+  // the accumulator, each structure of arrays
+  AlignedArray<TData> X(np), W(np), Y(size_t(m)*np), acc(size_t(m)*L);
+
+  for (long i0=0; i0<p; i0+=B){
+    const long nb = min(B, p-i0);
+    size_t j = 0;
+    for (long i=0; i<nb; i++){
+      const TData c = a + (TData(i0+i) + TData(0.5))*H;
+      for (TIndex k=0; k<rule.half_size(); k++, j++){
+        X[j] = c + h*xr[k];
+        W[j] = wr[k];
+      }
+      for (TIndex k=N%2; k<rule.half_size(); k++, j++){
+        X[j] = c - h*xr[k];
+        W[j] = wr[k];
+      }
+    }
+    for (; j<np; j++){
+      X[j] = X[0];
+      W[j] = TData(0);
+    }
+
+    f(static_cast<const TData*>(X.data()), long(np), Y.data());
+
+    for (int c=0; c<m; c++){
+      const TData* y = Y.data() + size_t(c)*np;
+      TData* s = acc.data() + size_t(c)*L;
+      for (size_t k=0; k<np; k+=L)
+        for (size_t l=0; l<L; l++)
+          s[l] += W[k+l]*y[k+l];
+    }
+  }
+
+  for (int c=0; c<m; c++){
+    TData Int = TData(0);
+    for (size_t l=0; l<L; l++)
+      Int += acc[size_t(c)*L+l];
+    result[c] = h*Int;
+  }
+}
+
+#endif // VECTOR_INTEGRATION_HPP
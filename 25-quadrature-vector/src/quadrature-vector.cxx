@@ -0,0 +1,158 @@
+/**
+ * \file quadrature-vector.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we compute the moments
+ *
+ *   int_0^1 x^k g(x) dx,   k=0,...,K-1,
+ *
+ * of an expensive function g by a composite Gauss rule, (a) with one
+ * FunctionBase object and one integration per moment, which evaluates g
+ * K times per point, (b) with one VectorFunctionBase object for all
+ * moments, and (c) with a batch integrand that evaluates g at many
+ * points at once and stores the moments as structure of arrays.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header files for standard utility library and containers
+#include <cstdlib>
+#include <vector>
+
+// Include header file for math functions
+#include <cmath>
+
+// Include header files for the benchmark harness, function objects
+// and vector-valued integration
+#include "Benchmark.hpp"
+#include "FunctionBase.hpp"
+#include "VectorIntegration.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// Number of moments
+const int K = 32;
+
+// The expensive function
+inline DataType g(DataType x){
+  return exp(-x)*cos(10.0*x) + log(1.0 + x*x);
+}
+
+// (a) The integrand of moment k as in 07-quadrature-oop2-templates
+class Moment : public FunctionBase<DataType>{
+public:
+  int k;
+  explicit Moment(int k) : k(k){}
+  DataType operator()(DataType x){
+    DataType p = 1.0;
+    for (int i=0; i<k; i++)
+      p *= x;
+    return p*g(x);
+  }
+};
+
+// (b) All moments at once
+class Moments : public VectorFunctionBase<DataType,K>{
+public:
+  void operator()(DataType x, DataType* y){
+    y[0] = g(x);
+    for (int k=1; k<K; k++)
+      y[k] = y[k-1]*x;
+  }
+};
+
+// (c) All moments at np points at once, component by component
+void moments_batch(const DataType* x, long np, DataType* Y){
+  for (long j=0; j<np; j++)
+    Y[j] = g(x[j]);
+  for (int k=1; k<K; k++)
+    for (long j=0; j<np; j++)
+      Y[k*np+j] = Y[(k-1)*np+j]*x[j];
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of panels from command line arguments
+  long p = 1000;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    p = atol(argv[1]);
+    break;
+  default:
+    cout << "Usage: quadrature-vector" << endl;
+    cout << "       quadrature-vector panels" << endl;
+    exit(-1);
+  }
+
+  const IndexType n = 5;
+  const DataType a = 0.0, b = 1.0, H = (b-a)/DataType(p);
+  const GaussRule<DataType,IndexType> rule(n);
+  vector<DataType> Ia(K), Ib(K), Ic(K);
+
+  auto scalar = [&](){
+    for (int k=0; k<K; k++){
+      Moment f(k);
+      Ia[k] = 0.0;
+      for (long i=0; i<p; i++)
+        Ia[k] += f.integrate(a + DataType(i)*H, a + DataType(i+1)*H, n);
+    }
+  };
+  auto vector_function = [&](){
+    Moments f;
+    for (int k=0; k<K; k++)
+      Ib[k] = 0.0;
+    for (long i=0; i<p; i++){
+      const array<DataType,K> I = f.integrate(a + DataType(i)*H, a + DataType(i+1)*H, n);
+      for (int k=0; k<K; k++)
+        Ib[k] += I[k];
+    }
+  };
+  auto batch = [&](){
+    integrate_batch(rule, moments_batch, a, b, p, K, Ic.data());
+  };
+
+  scalar();
+  vector_function();
+  batch();
+  DataType db = 0.0, dc = 0.0;
+  for (int k=0; k<K; k++){
+    db = max(db, abs(Ib[k]-Ia[k]));
+    dc = max(dc, abs(Ic[k]-Ia[k]));
+  }
+
+  cout.precision(15);
+  cout << K << " moments on " << p << " panels, " << n << "-pt Gauss rule" << endl;
+  cout << "  moment 0: " << Ia[0] << ", moment " << K-1 << ": " << Ia[K-1] << endl;
+  cout.precision(3);
+  cout << "  largest difference to (a): (b) " << db << ", (c) " << dc << endl;
+
+  // A lambda expression that returns a fixed-size vector
+  const array<DataType,2> cs = integrate_vector(rule, [](DataType x){
+      return array<DataType,2>{{cos(x), sin(x)}};
+    }, 0.0, 1.0);
+  cout << "  int_0^1 (cos(x), sin(x)) dx: error " << abs(cs[0]-sin(1.0)) << ", "
+       << abs(cs[1]-(1.0-cos(1.0))) << endl;
+
+  const double points = double(p)*double(n);
+  cout << "Time per quadrature point for all moments" << endl;
+  print("(a) FunctionBase per moment", benchmark(scalar, 5), points);
+  print("(b) VectorFunctionBase", benchmark(vector_function, 5), points);
+  print("(c) batch, structure of arrays", benchmark(batch, 5), points);
+
+  // End program
+  return 0;
+}
@@ -0,0 +1,204 @@
+/**
+ * \file ChebyshevProxy.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements a proxy of an expensive function f on a fixed
+ * interval [a,b]: the Chebyshev interpolant
+ *
+ * \verbatim
+ * p(x) = sum_{j=0}^{d} c_j T_j(t),   t = (2x-a-b)/(b-a),
+ * \endverbatim
+ *
+ * of f in the Chebyshev points x_k = cos(k*pi/n), k=0,...,n (mapped to
+ * [a,b]). The coefficients c_j are the discrete cosine transform
+ * (DCT-I) of the function values, computed by the real FFT of
+ * 12-quadrature-clenshaw-curtis in O(n log n). As in
+ * ClenshawCurtisRule::eval_nested, n is doubled, reusing the values of
+ * the previous level, until the coefficients have decayed below the
+ * tolerance; then the negligible tail is chopped, which gives the
+ * degree d and an estimate of the interpolation error.
+ *
+ * Afterwards, f is never called again: integrate(alpha, beta) for any
+ * [alpha,beta] in [a,b] evaluates the Chebyshev series of the
+ * antiderivative of p at alpha and beta by the Clenshaw recurrence in
+ * O(d), and the result is exact for p. The proxy is only valid on
+ * [a,b] (see domain and contains); queries outside throw.
+ *
+ */
+
+#ifndef CHEBYSHEV_PROXY_HPP
+#define CHEBYSHEV_PROXY_HPP
+
+// Include header files for complex numbers and mathematical functions
+#include <cmath>
+#include <complex>
+
+// Include header files for exceptions, pairs and the vector container
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Include header file for the FFT
+#include "FFT.hpp"
+
+using namespace std;
+
+// Templated class with data type TData for all floating point data
+// and data type TIndex for all index type data
+template<typename TData=double, typename TIndex=int>
+class ChebyshevProxy{
+
+private:
+  // Interval of validity
+  TData a, b;
+
+  // Chebyshev coefficients of the interpolant and of its antiderivative
+  // (scaled to x, with value zero at a)
+  vector<TData> c, C;
+
+  // Number of function evaluations, estimated error and convergence
+  TIndex nevals;
+  TData  errest;
+  bool   conv;
+
+  // Chebyshev coefficients of the values f_k at cos(k*pi/n), k=0,...,n:
+  // the FFT of the even extension f_0,...,f_n,f_{n-1},...,f_1 of
+  // length 2n is V_j = f_0 + (-1)^j f_n + 2 sum_{k=1}^{n-1} f_k
+  // cos(j*k*pi/n), and c_j = V_j/n, halved for j=0 and j=n
+  static vector<TData> coefficients(const vector<TData>& fv, TIndex n){
+    vector<TData> v(2*n);
+    for (TIndex k=0; k<=n; k++)
+      v[k] = fv[k];
+    for (TIndex k=1; k<n; k++)
+      v[2*n-k] = fv[k];
+    vector<complex<TData> > V(n+1);
+    rfft(v.data(), V.data(), 2*n);
+
+    vector<TData> coef(n+1);
+    for (TIndex j=0; j<=n; j++)
+      coef[j] = real(V[j])/TData(n);
+    coef[0] /= TData(2);
+    coef[n] /= TData(2);
+    return coef;
+  }
+
+  // Value of the Chebyshev series s at t by the Clenshaw recurrence
+  static TData clenshaw(const vector<TData>& s, TData t){
+    TData b1 = TData(0), b2 = TData(0);
+    for (size_t j=s.size()-1; j>0; j--){
+      const TData b0 = TData(2)*t*b1 - b2 + s[j];
+      b2 = b1;
+      b1 = b0;
+    }
+    return t*b1 - b2 + s[0];
+  }
+
+  // Map x in [a,b] to t in [-1,1]
+  TData to_reference(TData x) const {
+    if (!contains(x))
+      throw invalid_argument("Point outside of the domain of the Chebyshev proxy.");
+    return (TData(2)*x - a - b)/(b - a);
+  }
+
+public:
+  // Constructor: sample f on [a,b] with n=16,32,... subintervals until
+  // the coefficients have decayed to tol (relative to the largest one)
+  // or nmax is reached
+  template<typename TFunc>
+  ChebyshevProxy(TFunc f, TData a, TData b, TData tol=TData(1e-13), TIndex nmax=TIndex(1) << 16)
+    : a(a), b(b), nevals(0), errest(TData(0)), conv(false){
+    if (!(a < b))
+      throw invalid_argument("The domain [a,b] must satisfy a < b.");
+    if (!is_power_of_two(nmax) || nmax < 16)
+      throw invalid_argument("Maximal number of subintervals must be a power of two of at least 16.");
+
+    const TData pi = TData(4)*atan(TData(1));
+    const TData h = (b-a)/TData(2), m = (a+b)/TData(2);
+
+    TIndex n = 16;
+    vector<TData> fv(n+1);
+    for (TIndex k=0; k<=n; k++)
+      fv[k] = f(m + h*cos(TData(k)*pi/TData(n)));
+    nevals = n+1;
+
+    for (;;){
+      c = coefficients(fv, n);
+
+      // Converged if the last quarter of the coefficients is below tol
+      TData cmax = TData(0), tail = TData(0);
+      for (TIndex j=0; j<=n; j++)
+        cmax = max(cmax, abs(c[j]));
+      for (TIndex j=n-n/4; j<=n; j++)
+        tail = max(tail, abs(c[j]));
+      conv = (tail <= tol*cmax);
+      if (conv || 2*n > nmax)
+        break;
+
+      // Double n; the old points are the even ones of the new level
+      vector<TData> fnew(2*n+1);
+      for (TIndex k=0; k<=n; k++)
+        fnew[2*k] = fv[k];
+      for (TIndex k=0; k<n; k++)
+        fnew[2*k+1] = f(m + h*cos(TData(2*k+1)*pi/TData(2*n)));
+      nevals += n;
+      n *= 2;
+      fv.swap(fnew);
+    }
+
+    // Chop the tail: keep the coefficients up to the last one above
+    // tol*cmax; the sum of the dropped ones bounds the error of the
+    // truncated series, and the last computed coefficient estimates
+    // the interpolation error
+    TData cmax = TData(0);
+    for (TIndex j=0; j<=n; j++)
+      cmax = max(cmax, abs(c[j]));
+    TIndex d = n;
+    while (d > 0 && abs(c[d]) <= tol*cmax)
+      d--;
+    errest = abs(c[n]);
+    for (TIndex j=d+1; j<=n; j++)
+      errest += abs(c[j]);
+    c.resize(size_t(d)+1);
+
+    // Antiderivative in x, up to a constant: int T_0 = T_1,
+    // int T_1 = T_2/4 and int T_j = T_{j+1}/(2(j+1)) - T_{j-1}/(2(j-1)),
+    // times dx/dt = h. The constant is chosen such that it vanishes at a.
+    C.assign(size_t(d)+2, TData(0));
+    for (TIndex j=0; j<=d; j++){
+      const TData cj = h*c[j];
+      if (j == 0)
+        C[1] += cj;
+      else {
+        C[j+1] += cj/TData(2*(j+1));
+        if (j > 1)
+          C[j-1] -= cj/TData(2*(j-1));
+      }
+    }
+    C[0] -= clenshaw(C, TData(-1));
+  }
+
+  // Interval [a,b] on which the proxy is valid
+  pair<TData,TData> domain() const { return make_pair(a, b); }
+  bool contains(TData x) const { return a <= x && x <= b; }
+
+  // Degree of the interpolant, number of evaluations of f, estimated
+  // maximal error of the interpolant on [a,b] and whether the
+  // requested tolerance was reached
+  TIndex degree() const { return TIndex(c.size())-1; }
+  TIndex evaluations() const { return nevals; }
+  TData error() const { return errest; }
+  bool converged() const { return conv; }
+
+  // Value of the interpolant at x in [a,b]
+  TData operator()(TData x) const { return clenshaw(c, to_reference(x)); }
+
+  // Integral of the interpolant over [alpha,beta] in [a,b]
+  TData integrate(TData alpha, TData beta) const {
+    return clenshaw(C, to_reference(beta)) - clenshaw(C, to_reference(alpha));
+  }
+};
+
+#endif // CHEBYSHEV_PROXY_HPP
@@ -0,0 +1,160 @@
+/**
+ * \file quadrature-chebyshev.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we integrate an expensive function, the Bessel
+ * function J_0 computed from its integral representation, over many
+ * random subintervals of [0,20], (a) with FunctionBase::integrate on
+ * every subinterval, which calls J_0 again for every query, and (b)
+ * with a Chebyshev proxy that samples J_0 once and then answers all
+ * queries from its coefficients.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header files for standard utility library, containers,
+// function wrappers and random numbers
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+// Include header file for math functions
+#include <cmath>
+
+// Include header files for the benchmark harness, function objects
+// and the Chebyshev proxy
+#include "Benchmark.hpp"
+#include "ChebyshevProxy.hpp"
+#include "FunctionBase.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// The Bessel function J_0(x) = 1/pi int_0^pi cos(x sin(t)) dt by the
+// trapezoidal rule with M points, which converges exponentially for
+// the periodic integrand; every call costs M cosines and is counted
+class BesselJ0 : public FunctionBase<DataType>{
+public:
+  long calls;
+  BesselJ0() : calls(0){}
+  DataType operator()(DataType x){
+    const int M = 64;
+    const DataType pi = 4.0*atan(1.0);
+    DataType s = 0.0;
+    for (int k=0; k<M; k++)
+      s += cos(x*sin(pi*DataType(k)/DataType(M)));
+    calls++;
+    return s/DataType(M);
+  }
+};
+
+// Integral of f over [alpha,beta] by the composite n-point Gauss rule
+// of FunctionBase on p panels
+DataType composite(BesselJ0& f, DataType alpha, DataType beta, long p, IndexType n){
+  const DataType H = (beta-alpha)/DataType(p);
+  DataType Int = 0.0;
+  for (long i=0; i<p; i++)
+    Int += f.integrate(alpha + DataType(i)*H, alpha + DataType(i+1)*H, n);
+  return Int;
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of queries from command line arguments
+  long q = 1000;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    q = atol(argv[1]);
+    break;
+  default:
+    cout << "Usage: quadrature-chebyshev" << endl;
+    cout << "       quadrature-chebyshev queries" << endl;
+    exit(-1);
+  }
+
+  const DataType a = 0.0, b = 20.0;
+  BesselJ0 f;
+
+  // Random subintervals [alpha,beta] of [a,b]
+  mt19937 gen(42);
+  uniform_real_distribution<DataType> dist(a, b);
+  vector<DataType> alpha(q), beta(q);
+  for (long i=0; i<q; i++){
+    alpha[i] = dist(gen);
+    beta[i]  = dist(gen);
+  }
+
+  // Reference values by the composite 10-point Gauss rule on 64 panels
+  vector<DataType> Iref(q);
+  for (long i=0; i<q; i++)
+    Iref[i] = composite(f, alpha[i], beta[i], 64, 10);
+
+  // (a) Composite 10-point Gauss rule on 4 panels per query
+  f.calls = 0;
+  vector<DataType> Ia(q);
+  auto direct = [&](){
+    for (long i=0; i<q; i++)
+      Ia[i] = composite(f, alpha[i], beta[i], 4, 10);
+  };
+  direct();
+  const long calls_direct = f.calls;
+
+  // (b) The Chebyshev proxy, built once
+  f.calls = 0;
+  const ChebyshevProxy<DataType,IndexType> proxy(ref(f), a, b);
+  const long calls_proxy = f.calls;
+  vector<DataType> Ib(q);
+  auto chebyshev = [&](){
+    for (long i=0; i<q; i++)
+      Ib[i] = proxy.integrate(alpha[i], beta[i]);
+  };
+  chebyshev();
+
+  DataType ea = 0.0, eb = 0.0;
+  for (long i=0; i<q; i++){
+    ea = max(ea, abs(Ia[i]-Iref[i]));
+    eb = max(eb, abs(Ib[i]-Iref[i]));
+  }
+
+  cout.precision(3);
+  cout << "Chebyshev proxy of J_0 on [" << proxy.domain().first << ","
+       << proxy.domain().second << "]: degree " << proxy.degree()
+       << ", " << proxy.evaluations() << " evaluations, estimated error "
+       << proxy.error() << (proxy.converged() ? "" : " (not converged)") << endl;
+  cout << q << " random subintervals, largest error against the reference" << endl;
+  cout << "  (a) 10-pt Gauss on 4 panels:  " << ea << " (" << calls_direct << " calls)" << endl;
+  cout << "  (b) Chebyshev proxy:          " << eb << " (" << calls_proxy << " calls)" << endl;
+
+  // Queries outside of the domain are rejected
+  try{
+    proxy.integrate(-1.0, 1.0);
+  }
+  catch (const invalid_argument& e){
+    cout << "  integrate(-1,1): " << e.what() << endl;
+  }
+
+  cout << "Time per query" << endl;
+  print("(a) FunctionBase::integrate", benchmark(direct, 5), double(q));
+  print("(b) Chebyshev proxy", benchmark(chebyshev, 5), double(q));
+  print("(b) construction of the proxy", benchmark([&](){
+        const ChebyshevProxy<DataType,IndexType> p(ref(f), a, b);
+        do_not_optimize(p);
+      }, 5));
+
+  // End program
+  return 0;
+}
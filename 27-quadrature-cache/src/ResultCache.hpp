@@ -0,0 +1,393 @@
+/**
+ * \file ResultCache.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements a persistent cache of integrals in a file that
+ * is mapped into memory (mmap with MAP_SHARED), so that the results of
+ * one run are available to all later runs and to other processes that
+ * use the same file. An integral is identified by the name of the
+ * integrand, the exact bit patterns of a and b, the number of points n
+ * and the data type TData (its size and number of mantissa digits).
+ *
+ * The file is a hash table of fixed capacity with slots of 128 bytes
+ * and linear probing: the hash of the key selects a slot, and the key
+ * is searched in a window of 8 consecutive slots from there. A new
+ * entry takes the first empty slot of its window or evicts the least
+ * recently used entry of the window, so the file never grows beyond its
+ * initial size. Slots are never emptied again, so a search ends at the
+ * first empty slot, and a hit usually costs a single cache miss.
+ *
+ * Readers never lock: every slot has a sequence number that a writer
+ * makes odd while it modifies the slot and even again afterwards
+ * (seqlock), and a reader that sees an odd or changed sequence number
+ * reads the slot again. Writers are serialized by a mutex between the
+ * threads of a process and by flock between processes.
+ *
+ * A hit writes nothing that other readers share: the least recently
+ * used entry is found by a time stamp per slot from a coarse clock,
+ * which is only stored if it has changed, and hits and misses are
+ * counted per object in padded counters per thread. The destructor adds
+ * the counts to the totals over all runs in the file.
+ *
+ */
+
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+// Include header files for algorithms, atomics, fixed-width integers,
+// limits and the mutex
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+// Include header files for C strings, exceptions and strings
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// Include header files for files, memory mapping, file locks and
+// clocks
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace std;
+
+class ResultCache{
+
+public:
+  // Maximal length of the name of an integrand and number of slots
+  // searched per key
+  static constexpr size_t name_size   = 31;
+  static constexpr size_t window_size = 8;
+
+private:
+  // Header of the file, followed by the slots
+  struct alignas(64) Header{
+    char             magic[8];
+    uint64_t         capacity;
+    atomic<uint64_t> entries, hits, misses, evictions;
+  };
+
+  // A slot holds one key and its value; a and b and the value are
+  // stored in 16 bytes, which is enough for all floating point types
+  struct alignas(64) Slot{
+    atomic<uint64_t> seq, stamp;
+    uint64_t         hash;
+    int64_t          n;
+    uint32_t         type, used;
+    char             name[name_size+1];
+    unsigned char    a[16], b[16], value[16];
+  };
+
+  static_assert(sizeof(Header) == 64 && sizeof(Slot) == 128, "Unexpected layout of the cache file.");
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The cache requires lock-free 64-bit atomics.");
+
+  // The key of an integral, with a and b as bit patterns; the hash is
+  // computed from the words that follow it
+  struct Key{
+    uint64_t      hash;
+    int64_t       n;
+    uint64_t      type;
+    char          name[name_size+1];
+    unsigned char a[16], b[16];
+  };
+  static_assert(sizeof(Key) == 88, "Unexpected layout of the key.");
+
+  int     fd;
+  size_t  bytes;
+  Header* header;
+  Slot*   slots;
+  mutex   write_mutex;
+
+  // Hits and misses of this object, one padded pair of counters per
+  // stripe so that threads do not share a cache line (see
+  // PerTaskAccumulator in 18-quadrature-parallel), and evictions, which
+  // are counted under the write lock
+  static constexpr size_t stripes = 16;
+  struct alignas(64) Counters{
+    atomic<uint64_t> hits, misses;
+  };
+  Counters counters[stripes];
+  atomic<uint64_t> nevictions;
+
+  // Stripe of the calling thread
+  static size_t stripe(){
+    static atomic<size_t> next(0);
+    thread_local size_t s = next.fetch_add(1, memory_order_relaxed) % stripes;
+    return s;
+  }
+
+  // Coarse wall-clock time in milliseconds for the time stamps; it is
+  // comparable between processes and runs
+  static uint64_t now(){
+    timespec ts;
+#ifdef CLOCK_REALTIME_COARSE
+    ::clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+#else
+    ::clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+    return uint64_t(ts.tv_sec)*1000 + uint64_t(ts.tv_nsec)/1000000;
+  }
+
+  static runtime_error error(const string& what, const string& path){
+    return runtime_error(what + " " + path + ": " + strerror(errno));
+  }
+
+  // Exclusive lock of the file between processes
+  class FileLock{
+    int fd;
+  public:
+    explicit FileLock(int fd) : fd(fd){ ::flock(fd, LOCK_EX); }
+    ~FileLock(){ ::flock(fd, LOCK_UN); }
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+  };
+
+  // Bytes of the value representation of TData; the x87 extended
+  // precision type has 64 mantissa digits and 6 bytes of padding
+  template<typename TData>
+  static constexpr size_t value_bytes(){
+    return numeric_limits<TData>::digits == 64 && sizeof(TData) > 10 ? 10 : sizeof(TData);
+  }
+
+  // Hash of the n words w[0],...,w[n-1] by multiplication and shift
+  static uint64_t hash_words(const uint64_t* w, size_t n){
+    uint64_t h = 0;
+    for (size_t i=0; i<n; i++){
+      h = (h ^ w[i])*0x9e3779b97f4a7c15ULL;
+      h ^= h >> 32;
+    }
+    return h;
+  }
+
+  template<typename TData, typename TIndex>
+  static Key make_key(const string& name, TData a, TData b, TIndex n){
+    static_assert(sizeof(TData) <= 16, "Data type is too large for the cache.");
+    if (name.empty() || name.size() > name_size)
+      throw invalid_argument("Name of the integrand must have 1 to " + to_string(name_size) + " characters.");
+
+    Key k;
+    memset(&k, 0, sizeof(k));
+    memcpy(k.name, name.data(), name.size());
+    memcpy(k.a, &a, value_bytes<TData>());
+    memcpy(k.b, &b, value_bytes<TData>());
+    k.n    = int64_t(n);
+    k.type = uint64_t(sizeof(TData)) << 16 | uint64_t(numeric_limits<TData>::digits);
+
+    uint64_t w[(sizeof(Key)-sizeof(uint64_t))/sizeof(uint64_t)];
+    memcpy(w, &k.n, sizeof(w));
+    k.hash = hash_words(w, sizeof(w)/sizeof(uint64_t));
+    return k;
+  }
+
+  static bool matches(const Slot& s, const Key& k){
+    return s.used && s.hash == k.hash && s.n == k.n && s.type == uint32_t(k.type)
+      && memcmp(s.name, k.name, sizeof(k.name)) == 0
+      && memcmp(s.a, k.a, sizeof(k.a)) == 0 && memcmp(s.b, k.b, sizeof(k.b)) == 0;
+  }
+
+  // Slot i of the window of a key
+  Slot& probe(const Key& k, size_t i) const {
+    return slots[(k.hash + i) % header->capacity];
+  }
+
+public:
+  // Constructor: open the cache file path, or create it with room for
+  // capacity entries (at least the window size). An existing file keeps
+  // its capacity.
+  explicit ResultCache(const string& path, size_t capacity=size_t(1) << 16)
+    : fd(::open(path.c_str(), O_RDWR | O_CREAT, 0644)), bytes(0), header(nullptr), slots(nullptr),
+      nevictions(0){
+    for (size_t i=0; i<stripes; i++){
+      counters[i].hits.store(0, memory_order_relaxed);
+      counters[i].misses.store(0, memory_order_relaxed);
+    }
+    if (fd < 0)
+      throw error("Cannot open", path);
+    if (capacity < 1){
+      ::close(fd);
+      throw invalid_argument("Capacity of the cache must be positive.");
+    }
+    capacity = max(capacity, window_size);
+
+    // Only one process initializes a new file
+    FileLock lock(fd);
+    struct stat st;
+    if (::fstat(fd, &st) != 0){
+      ::close(fd);
+      throw error("Cannot stat", path);
+    }
+    const bool created = (st.st_size == 0);
+    if (created){
+      bytes = sizeof(Header) + capacity*sizeof(Slot);
+      if (::ftruncate(fd, off_t(bytes)) != 0){
+        ::close(fd);
+        throw error("Cannot resize", path);
+      }
+    }
+    else
+      bytes = size_t(st.st_size);
+
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED){
+      ::close(fd);
+      throw error("Cannot map", path);
+    }
+    header = static_cast<Header*>(p);
+    slots  = reinterpret_cast<Slot*>(header+1);
+
+    // The file is zero-filled by ftruncate, which is a valid empty table
+    if (created){
+      memcpy(header->magic, "QUADRC02", 8);
+      header->capacity = capacity;
+    }
+    else if (memcmp(header->magic, "QUADRC02", 8) != 0 || header->capacity < window_size
+             || bytes != sizeof(Header) + header->capacity*sizeof(Slot)){
+      ::munmap(p, bytes);
+      ::close(fd);
+      throw invalid_argument("File " + path + " is not a result cache.");
+    }
+  }
+
+  // Destructor: add the counts of this object to the totals in the
+  // file. The mapping is shared, so all entries are already in the file
+  // (or the page cache of the operating system).
+  ~ResultCache(){
+    header->hits.fetch_add(hits(), memory_order_relaxed);
+    header->misses.fetch_add(misses(), memory_order_relaxed);
+    header->evictions.fetch_add(evictions(), memory_order_relaxed);
+    ::munmap(header, bytes);
+    ::close(fd);
+  }
+
+  ResultCache(const ResultCache&) = delete;
+  ResultCache& operator=(const ResultCache&) = delete;
+
+  // Look up the integral of the integrand name over [a,b] with n
+  // points; returns true and sets value on a hit
+  template<typename TData, typename TIndex>
+  bool lookup(const string& name, TData a, TData b, TIndex n, TData& value){
+    const Key k = make_key(name, a, b, n);
+    bool end = false;
+    for (size_t i=0; i<window_size && !end; i++){
+      Slot& slot = probe(k, i);
+      // A slot that stays odd belongs to a writer that died while
+      // writing it; it is skipped and repaired by the next insert
+      for (int retry=0; retry<(1 << 16); retry++){
+        const uint64_t seq = slot.seq.load(memory_order_acquire);
+        if (seq & 1)
+          continue;
+        const bool hit = matches(slot, k);
+        end = !slot.used;
+        unsigned char v[16];
+        memcpy(v, slot.value, sizeof(v));
+        atomic_thread_fence(memory_order_acquire);
+        if (slot.seq.load(memory_order_relaxed) != seq)
+          continue;
+        if (!hit)
+          break;
+
+        memcpy(&value, v, sizeof(TData));
+        const uint64_t t = now();
+        if (slot.stamp.load(memory_order_relaxed) < t)
+          slot.stamp.store(t, memory_order_relaxed);
+        counters[stripe()].hits.fetch_add(1, memory_order_relaxed);
+        return true;
+      }
+    }
+    counters[stripe()].misses.fetch_add(1, memory_order_relaxed);
+    return false;
+  }
+
+  // Store the integral of the integrand name over [a,b] with n points
+  template<typename TData, typename TIndex>
+  void insert(const string& name, TData a, TData b, TIndex n, TData value){
+    const Key k = make_key(name, a, b, n);
+    lock_guard<mutex> guard(write_mutex);
+    FileLock lock(fd);
+
+    // Existing entry or the first empty slot of the window, else the
+    // least recently used entry of the window
+    Slot* target = nullptr;
+    for (size_t i=0; i<window_size && !target; i++){
+      Slot& slot = probe(k, i);
+      if (!slot.used || matches(slot, k))
+        target = &slot;
+    }
+    if (!target){
+      target = &probe(k, 0);
+      for (size_t i=1; i<window_size; i++)
+        if (probe(k, i).stamp.load(memory_order_relaxed) < target->stamp.load(memory_order_relaxed))
+          target = &probe(k, i);
+      nevictions.fetch_add(1, memory_order_relaxed);
+    }
+    else if (!target->used)
+      header->entries.fetch_add(1, memory_order_relaxed);
+
+    const uint64_t seq = target->seq.load(memory_order_relaxed) & ~uint64_t(1);
+    target->seq.store(seq+1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    target->hash = k.hash;
+    target->n    = k.n;
+    target->type = uint32_t(k.type);
+    target->used = 1;
+    memcpy(target->name, k.name, sizeof(k.name));
+    memcpy(target->a, k.a, sizeof(k.a));
+    memcpy(target->b, k.b, sizeof(k.b));
+    memset(target->value, 0, sizeof(target->value));
+    memcpy(target->value, &value, sizeof(TData));
+    target->stamp.store(now(), memory_order_relaxed);
+    target->seq.store(seq+2, memory_order_release);
+  }
+
+  // Integral of the integrand name over [a,b] with n points: the cached
+  // value, or driver(a, b, n), which is then stored in the cache
+  template<typename TData, typename TIndex, typename TDriver>
+  TData integrate(const string& name, TDriver driver, TData a, TData b, TIndex n){
+    TData value;
+    if (lookup(name, a, b, n, value))
+      return value;
+    value = driver(a, b, n);
+    insert(name, a, b, n, value);
+    return value;
+  }
+
+  // Capacity and number of entries of the cache
+  size_t capacity() const { return size_t(header->capacity); }
+  size_t size() const { return size_t(header->entries.load(memory_order_relaxed)); }
+
+  // Hits, misses and evictions of this object
+  uint64_t hits() const {
+    uint64_t s = 0;
+    for (size_t i=0; i<stripes; i++)
+      s += counters[i].hits.load(memory_order_relaxed);
+    return s;
+  }
+  uint64_t misses() const {
+    uint64_t s = 0;
+    for (size_t i=0; i<stripes; i++)
+      s += counters[i].misses.load(memory_order_relaxed);
+    return s;
+  }
+  uint64_t evictions() const { return nevictions.load(memory_order_relaxed); }
+
+  // Hits, misses and evictions of all earlier users of the file that
+  // have been destroyed, and of this object
+  uint64_t total_hits() const { return header->hits.load(memory_order_relaxed) + hits(); }
+  uint64_t total_misses() const { return header->misses.load(memory_order_relaxed) + misses(); }
+  uint64_t total_evictions() const {
+    return header->evictions.load(memory_order_relaxed) + evictions();
+  }
+};
+
+#endif // RESULT_CACHE_HPP
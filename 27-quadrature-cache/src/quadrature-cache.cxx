@@ -0,0 +1,166 @@
+/**
+ * \file quadrature-cache.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version the integrals of a batch of queries are stored in a
+ * persistent result cache in front of FunctionBase::integrate. The
+ * first run of the program computes and stores all integrals; every
+ * later run with the same cache file finds them and does not integrate
+ * at all. The program also reads the cache from several threads at
+ * once and shows the eviction of old entries from a small cache.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header files for standard utility library, containers,
+// futures and random numbers
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <random>
+#include <string>
+#include <vector>
+
+// Include header files for clocks and math functions
+#include <chrono>
+#include <cmath>
+
+// Include header files for function objects, the thread pool and the
+// result cache
+#include "FunctionBase.hpp"
+#include "ResultCache.hpp"
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+// Define data types
+typedef double DataType;
+typedef int    IndexType;
+
+// The Bessel function J_0(x) = 1/pi int_0^pi cos(x sin(t)) dt by the
+// trapezoidal rule with M points (see 26-quadrature-chebyshev); every
+// call costs M cosines and is counted
+class BesselJ0 : public FunctionBase<DataType>{
+public:
+  long calls;
+  BesselJ0() : calls(0){}
+  DataType operator()(DataType x){
+    const int M = 64;
+    const DataType pi = 4.0*atan(1.0);
+    DataType s = 0.0;
+    for (int k=0; k<M; k++)
+      s += cos(x*sin(pi*DataType(k)/DataType(M)));
+    calls++;
+    return s/DataType(M);
+  }
+};
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get cache file and number of queries from command line arguments
+  string path = "quadrature-cache.bin";
+  long q = 10000;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    path = argv[1];
+    break;
+  case 3:
+    path = argv[1];
+    q = atol(argv[2]);
+    break;
+  default:
+    cout << "Usage: quadrature-cache" << endl;
+    cout << "       quadrature-cache cachefile" << endl;
+    cout << "       quadrature-cache cachefile queries" << endl;
+    exit(-1);
+  }
+
+  // The same queries in every run
+  mt19937 gen(42);
+  uniform_real_distribution<DataType> dist(0.0, 20.0);
+  vector<DataType> A(q), B(q);
+  vector<IndexType> N(q);
+  for (long i=0; i<q; i++){
+    A[i] = dist(gen);
+    B[i] = dist(gen);
+    N[i] = IndexType(1 + gen() % 10);
+  }
+
+  BesselJ0 f;
+  auto driver = [&f](DataType a, DataType b, IndexType n){ return f.integrate(a, b, n); };
+
+  // Integrate all queries through the cache
+  auto batch = [&](ResultCache& cache, const char* name){
+    const long calls = f.calls;
+    DataType sum = 0.0;
+    auto start = chrono::steady_clock::now();
+    for (long i=0; i<q; i++)
+      sum += cache.integrate("J0", driver, A[i], B[i], N[i]);
+    const double t = chrono::duration<double>(chrono::steady_clock::now()-start).count();
+    cout << "  " << name << ": " << cache.hits() << " hits, " << cache.misses() << " misses, "
+         << f.calls-calls << " calls of J_0, " << 1e9*t/double(q) << " ns per query (sum "
+         << sum << ")" << endl;
+  };
+
+  cout.precision(6);
+  {
+    ResultCache cache(path);
+    cout << "Cache " << path << ": " << cache.size() << " of " << cache.capacity()
+         << " entries, " << cache.total_hits() << " hits and " << cache.total_misses()
+         << " misses in earlier runs" << endl;
+    batch(cache, "this run  ");
+  }
+  {
+    // A rerun with the same cache file finds all integrals
+    ResultCache cache(path);
+    batch(cache, "rerun     ");
+
+    // Concurrent readers
+    unsigned threads = thread::hardware_concurrency();
+    ThreadPool pool(threads > 0 ? threads : 4);
+    vector<future<long> > hits;
+    for (unsigned t=0; t<pool.size(); t++)
+      hits.push_back(pool.submit([&](){
+            long h = 0;
+            DataType v;
+            for (long i=0; i<q; i++)
+              h += cache.lookup("J0", A[i], B[i], N[i], v);
+            return h;
+          }));
+    long total = 0;
+    for (auto& h : hits)
+      total += h.get();
+    cout << "  " << pool.size() << " concurrent readers: " << total << " hits of "
+         << long(pool.size())*q << " lookups" << endl;
+
+    // The key contains the exact bit patterns of a and b and the type
+    DataType v;
+    float vf;
+    cout << "  a+1ulp is a hit: " << cache.lookup("J0", nextafter(A[0], INFINITY), B[0], N[0], v)
+         << ", float is a hit: " << cache.lookup("J0", float(A[0]), float(B[0]), N[0], vf) << endl;
+  }
+  {
+    // A small cache keeps its size and evicts the least recently used
+    // entries of a bucket
+    const string small = path + ".small";
+    remove(small.c_str());
+    ResultCache cache(small, 1024);
+    batch(cache, "small cache");
+    cout << "  " << cache.size() << " of " << cache.capacity() << " entries, "
+         << cache.evictions() << " evictions" << endl;
+    remove(small.c_str());
+  }
+
+  // End program
+  return 0;
+}
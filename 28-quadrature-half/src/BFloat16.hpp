@@ -0,0 +1,102 @@
+/**
+ * \file BFloat16.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This class implements the bfloat16 number type: the upper 16 bits of
+ * an IEEE float, i.e., the same exponent range as float but only 8
+ * significant bits (about 2-3 decimal digits). Compilers provide it as
+ * __bf16 or std::bfloat16_t (C++23) only recently and often just as a
+ * storage type, so here it is a class that stores the 16 bits and
+ * computes every operation in float, rounding the result to the nearest
+ * bfloat16 (ties to even). On CPUs with bfloat16 instructions the
+ * conversions are single instructions, but the arithmetic is in float
+ * there as well.
+ *
+ * Like the dual numbers of 08-quadrature-autodiff, the class provides
+ * what the quadrature rules need: a constructor from arithmetic types
+ * and the arithmetic operators. The conversion to float is explicit, so
+ * that mixed expressions such as x + 1 are not ambiguous.
+ *
+ */
+
+#ifndef BFLOAT16_HPP
+#define BFLOAT16_HPP
+
+// Include header files for fixed-width integers, C strings and type
+// traits
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Include header file for standard output stream library
+#include <ostream>
+
+// Include header file for the data type of the sums
+#include "Accumulator.hpp"
+
+using namespace std;
+
+class BFloat16{
+
+private:
+  // The upper 16 bits of the float
+  uint16_t bits;
+
+  // Round the float v to the nearest bfloat16, ties to even; NaNs stay
+  // (quiet) NaNs
+  static uint16_t round(float v){
+    uint32_t u;
+    memcpy(&u, &v, sizeof(u));
+    if ((u & 0x7fffffffu) > 0x7f800000u)
+      return uint16_t((u >> 16) | 0x0040u);
+    u += 0x7fffu + ((u >> 16) & 1u);
+    return uint16_t(u >> 16);
+  }
+
+public:
+  // Constructors: zero and from any arithmetic type (via float)
+  BFloat16() : bits(0){}
+
+  template<typename T, typename = typename enable_if<is_arithmetic<T>::value>::type>
+  BFloat16(T v) : bits(round(float(v))){}
+
+  // Explicit conversion to float and double, which are exact
+  explicit operator float() const {
+    const uint32_t u = uint32_t(bits) << 16;
+    float v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+  }
+  explicit operator double() const { return double(float(*this)); }
+
+  // Arithmetic operators, computed in float and rounded
+  friend BFloat16 operator+(BFloat16 x, BFloat16 y){ return BFloat16(float(x) + float(y)); }
+  friend BFloat16 operator-(BFloat16 x, BFloat16 y){ return BFloat16(float(x) - float(y)); }
+  friend BFloat16 operator*(BFloat16 x, BFloat16 y){ return BFloat16(float(x) * float(y)); }
+  friend BFloat16 operator/(BFloat16 x, BFloat16 y){ return BFloat16(float(x) / float(y)); }
+  friend BFloat16 operator-(BFloat16 x){ return BFloat16(-float(x)); }
+
+  BFloat16& operator+=(BFloat16 y){ return *this = *this + y; }
+  BFloat16& operator-=(BFloat16 y){ return *this = *this - y; }
+  BFloat16& operator*=(BFloat16 y){ return *this = *this * y; }
+  BFloat16& operator/=(BFloat16 y){ return *this = *this / y; }
+
+  // Comparison operators
+  friend bool operator==(BFloat16 x, BFloat16 y){ return float(x) == float(y); }
+  friend bool operator!=(BFloat16 x, BFloat16 y){ return float(x) != float(y); }
+  friend bool operator<(BFloat16 x, BFloat16 y){ return float(x) < float(y); }
+  friend bool operator>(BFloat16 x, BFloat16 y){ return float(x) > float(y); }
+
+  friend ostream& operator<<(ostream& os, BFloat16 x){ return os << float(x); }
+};
+
+// The sums of the quadrature rules are computed in float
+template<>
+struct Accumulator<BFloat16>{
+  typedef float type;
+};
+
+#endif // BFLOAT16_HPP
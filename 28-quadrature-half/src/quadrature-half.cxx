@@ -0,0 +1,129 @@
+/**
+ * \file quadrature-half.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this version we use GaussRule and FunctionBase with 16-bit
+ * floating point types, _Float16 (IEEE half precision, 11 significant
+ * bits) and bfloat16 (8 significant bits), for sweeps that only need
+ * 2-3 digits. Points and function values are computed in the 16-bit
+ * type, the sums in float (see Accumulator). We compare the accuracy
+ * and the time per point with float and double for the composite rule
+ * applied to 1/(1+x^2) on [0,1].
+ *
+ * By default the program is compiled without ISA flags, so that GCC
+ * converts _Float16 by library calls and the _Float16 row is about 100
+ * times slower than float. With QUAD_HALF_NATIVE (see CMakeLists.txt)
+ * the conversions are F16C instructions.
+ */
+
+// Include header file for standard input/output stream library
+#include <iostream>
+
+// Include header files for standard utility library and containers
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Include math constants; for a list of supported constants see
+// http://www.gnu.org/software/libc/manual/html_node/Mathematical-Constants.html
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+// Include header files for quadrature rules, function objects, the
+// bfloat16 type and the benchmark harness
+#include "BFloat16.hpp"
+#include "Benchmark.hpp"
+#include "FunctionBase.hpp"
+#include "GaussRule.hpp"
+
+using namespace std;
+
+// Define data types
+typedef int IndexType;
+
+// The integrand 1/(1+x^2) as function object; all constants are
+// converted to TData
+template<typename TData>
+class Runge : public FunctionBase<TData>{
+public:
+  TData operator()(TData x){
+    return TData(1)/(TData(1) + x*x);
+  }
+};
+
+// Composite n-point Gauss rule on p panels of [0,1] in data type TData:
+// accuracy and time per point
+template<typename TData>
+void run(const string& name, long p, IndexType n){
+  typedef typename Accumulator<TData>::type TAcc;
+
+  GaussRule<TData,IndexType> rule(n);
+  Runge<TData> f;
+
+  // The end points of the panels are rounded to TData once, so that
+  // neighbouring panels share them and the panels cover [0,1] exactly
+  vector<TData> X(p+1);
+  for (long i=0; i<=p; i++)
+    X[i] = TData(double(i)/double(p));
+
+  // Sum of the panels in the accumulator type and, for comparison, in
+  // TData itself
+  TAcc Int = TAcc(0);
+  TData Naive = TData(0);
+  auto composite = [&](){
+    Int = TAcc(0);
+    for (long i=0; i<p; i++)
+      Int += TAcc(rule.eval([&f](TData x){ return f(x); }, X[i], X[i+1]));
+    do_not_optimize(Int);
+  };
+  composite();
+  for (long i=0; i<p; i++)
+    Naive += rule.eval([&f](TData x){ return f(x); }, X[i], X[i+1]);
+  const TData One = f.integrate(TData(0), TData(1), 10);
+
+  const double exact = M_PI/4.0;
+  cout << name << ": relative errors " << abs(double(Int) - exact)/exact
+       << " (panels summed in " << sizeof(TAcc)*8 << " bit), "
+       << abs(double(Naive) - exact)/exact << " (summed in " << sizeof(TData)*8 << " bit), "
+       << abs(double(One) - exact)/exact << " (FunctionBase, 10 points)" << endl;
+  print("  time per point", benchmark(composite), double(p)*double(n));
+}
+
+// The global main function that is the designated start of the
+// program.
+int main (int argc,  char** argv){
+
+  // Get number of panels from command line arguments
+  long p = 1000;
+
+  switch (argc){
+  case 1:
+    // adopt default values initialized above
+    break;
+  case 2:
+    p = atol(argv[1]);
+    break;
+  default:
+    cout << "Usage: quadrature-half" << endl;
+    cout << "       quadrature-half panels" << endl;
+    exit(-1);
+  }
+
+  const IndexType n = 5;
+  cout.precision(3);
+  cout << "Composite " << n << "-pt Gauss rule on " << p << " panels, int_0^1 1/(1+x^2) dx" << endl;
+  run<double>("double  ", p, n);
+  run<float>("float   ", p, n);
+#ifdef __FLT16_MAX__
+  run<_Float16>("_Float16", p, n);
+#else
+  cout << "_Float16: not supported by this compiler" << endl;
+#endif
+  run<BFloat16>("bfloat16", p, n);
+
+  // End program
+  return 0;
+}
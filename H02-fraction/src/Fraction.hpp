@@ -0,0 +1,266 @@
+/**
+ * \file Fraction.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements the fraction class of homework 2 with all three
+ * tasks solved. Everything is constexpr, so that fractions can be
+ * computed exactly by the compiler, e.g., the weights of quadrature
+ * rules (see 22-quadrature-newton-cotes). The integer type TInt is a
+ * template parameter; wide types such as long long (or __int128 with
+ * GCC and Clang) postpone overflow in long computations.
+ *
+ * Arithmetic overflow throws std::overflow_error. In a constant
+ * expression this stops the compilation instead of producing a wrong
+ * result.
+ *
+ */
+
+#ifndef FRACTION_HPP
+#define FRACTION_HPP
+
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+// Greatest common divisor; the result is negative if b is negative (or
+// if b is zero and a is negative)
+template<typename TInt>
+constexpr TInt gcd(TInt a, TInt b)
+{
+    while (b)
+    {
+        TInt c = a%b;
+        a = b;
+        b = c;
+    }
+    return a;
+}
+
+// Integer operations that throw on overflow
+template<typename TInt>
+constexpr TInt checked_add(TInt a, TInt b)
+{
+    TInt c = 0;
+#if defined(__GNUC__) || defined(__clang__)
+    if (__builtin_add_overflow(a, b, &c))
+        throw std::overflow_error("Fraction: integer overflow in addition.");
+#else
+    c = a+b;
+#endif
+    return c;
+}
+
+template<typename TInt>
+constexpr TInt checked_mul(TInt a, TInt b)
+{
+    TInt c = 0;
+#if defined(__GNUC__) || defined(__clang__)
+    if (__builtin_mul_overflow(a, b, &c))
+        throw std::overflow_error("Fraction: integer overflow in multiplication.");
+#else
+    c = a*b;
+#endif
+    return c;
+}
+
+template<typename TInt=int>
+class Fraction
+{
+public:
+
+    constexpr Fraction(TInt _n=0, TInt _d=1): n(_n), d(_d)
+    {
+        if (d == 0)
+            throw std::invalid_argument("Fraction: denominator must not be zero.");
+    }
+
+    // Task 3: optionally normalized upon instantiation
+    constexpr Fraction(TInt _n, TInt _d, bool _normalize): Fraction(_n, _d)
+    {
+        if (_normalize)
+            normalize();
+    }
+
+    // Task 2: divide numerator and denominator by their greatest common
+    // divisor and make the denominator positive, e.g. 14/-6 -> -7/3
+    constexpr Fraction &normalize()
+    {
+        TInt g = ::gcd(n, d);
+        if (g < 0)
+            g = -g;
+        n /= g;
+        d /= g;
+        if (d < 0)
+        {
+            n = -n;
+            d = -d;
+        }
+        return *this;
+    }
+
+    constexpr Fraction operator-() const { return Fraction(-n, d); }
+
+    explicit constexpr operator double() const { return double(n)/double(d); }
+
+    // Value in the floating-point type TData, correctly rounded (to
+    // nearest, ties to even) for binary types with up to 64 significant
+    // bits: the first digits+1 bits of the quotient are computed from
+    // the integers by long division, the remainder decides the rounding,
+    // and only the final scaling by a power of two is done in TData,
+    // which is exact unless the result over- or underflows. Other types
+    // get the correctly rounded double, converted to TData (a second
+    // rounding).
+    template<typename TData>
+    constexpr TData value() const
+    {
+        typedef std::numeric_limits<TData> limits;
+        if (!limits::is_specialized || limits::radix != 2 || limits::digits < 1
+            || limits::digits > 64)
+            return TData(value<double>());
+        const int p = limits::digits;
+
+        const bool negative = (n < 0) != (d < 0);
+        TInt a = n < 0 ? -n : n, b = d < 0 ? -d : d;
+        if (a == 0)
+            return TData(0);
+
+        // Integer part q with L bits and remainder r
+        TInt q = a/b, r = a%b;
+        int L = 0;
+        for (TInt t = q; t > 0; t /= 2)
+            L++;
+
+        // Collect the p bits of the quotient from its leading one bit in
+        // m and the next bit in guard; the leading bit has the value 2^e
+        unsigned long long m = 0;
+        bool started = (L > 0), guard = false;
+        int e = L-1, count = 0, i = L-1, k = 0;
+        while (count <= p)
+        {
+            bool bit = false;
+            if (i >= 0)
+                bit = ((q >> i--) & 1) != 0;
+            else
+            {
+                // Next bit of r/b; r < b, so 2r is formed without overflow
+                k++;
+                if (r >= b-r)
+                {
+                    r -= b-r;
+                    bit = true;
+                }
+                else
+                    r += r;
+                if (!started && bit)
+                {
+                    started = true;
+                    e = -k;
+                }
+            }
+            if (!started)
+                continue;
+            if (count < p)
+                m = (m << 1) | (bit ? 1ULL : 0ULL);
+            else
+                guard = bit;
+            count++;
+        }
+
+        // All remaining bits decide ties
+        bool sticky = (r != 0);
+        if (i >= 0)
+            sticky = sticky || (q & ((TInt(1) << (i+1)) - 1)) != 0;
+
+        if (guard && (sticky || (m & 1)))
+        {
+            m++;
+            if (m == (1ULL << (p-1) << 1))
+            {
+                m = 1ULL << (p-1);
+                e++;
+            }
+        }
+
+        // m * 2^(e-p+1), scaled exactly
+        TData v = TData(m);
+        for (int s = e-p+1; s > 0; s--)
+            v *= TData(2);
+        for (int s = e-p+1; s < 0; s++)
+            v /= TData(2);
+        return negative ? -v : v;
+    }
+
+    // Task 1: the operators below are defined inside the class
+    // (hidden friends), so that an integer on either side is converted,
+    // e.g. 1+a. All results are normalized, which keeps the numbers
+    // small; for + and * the common factors are cancelled before
+    // multiplying.
+    friend constexpr Fraction operator+(const Fraction &l, const Fraction &r)
+    {
+        const TInt g = abs_gcd(l.d, r.d);
+        return Fraction(checked_add(checked_mul(l.n, r.d/g), checked_mul(r.n, l.d/g)),
+                        checked_mul(l.d/g, r.d), true);
+    }
+
+    friend constexpr Fraction operator-(const Fraction &l, const Fraction &r)
+    {
+        return l + (-r);
+    }
+
+    friend constexpr Fraction operator*(const Fraction &l, const Fraction &r)
+    {
+        const TInt g1 = abs_gcd(l.n, r.d), g2 = abs_gcd(r.n, l.d);
+        return Fraction(checked_mul(l.n/g1, r.n/g2), checked_mul(l.d/g2, r.d/g1), true);
+    }
+
+    friend constexpr Fraction operator/(const Fraction &l, const Fraction &r)
+    {
+        if (r.n == 0)
+            throw std::domain_error("Fraction: division by zero.");
+        return l * Fraction(r.d, r.n);
+    }
+
+    constexpr Fraction &operator+=(const Fraction &r) { return *this = *this + r; }
+    constexpr Fraction &operator-=(const Fraction &r) { return *this = *this - r; }
+    constexpr Fraction &operator*=(const Fraction &r) { return *this = *this * r; }
+    constexpr Fraction &operator/=(const Fraction &r) { return *this = *this / r; }
+
+    // Comparison of the values, i.e. 2/4 == 1/2
+    friend constexpr bool operator==(const Fraction &l, const Fraction &r)
+    {
+        const Fraction a = Fraction(l.n, l.d, true), b = Fraction(r.n, r.d, true);
+        return a.n == b.n && a.d == b.d;
+    }
+
+    friend constexpr bool operator!=(const Fraction &l, const Fraction &r)
+    {
+        return !(l == r);
+    }
+
+    friend constexpr bool operator<(const Fraction &l, const Fraction &r)
+    {
+        return (l - r).n < 0;
+    }
+
+    TInt n, d;
+
+private:
+
+    // Non-negative greatest common divisor, 1 if both are zero
+    static constexpr TInt abs_gcd(TInt a, TInt b)
+    {
+        TInt g = ::gcd(a, b);
+        return g < 0 ? -g : (g == 0 ? TInt(1) : g);
+    }
+};
+
+template<typename TInt>
+std::ostream &operator<<(std::ostream &os, const Fraction<TInt> &f)
+{
+    return os << f.n << "/" << f.d;
+}
+
+#endif // FRACTION_HPP
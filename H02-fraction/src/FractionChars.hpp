@@ -0,0 +1,146 @@
+/**
+ * \file FractionChars.hpp
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * This file implements conversions of fractions to and from the text
+ * "n/d" in the style of std::to_chars and std::from_chars (C++17): the
+ * caller provides the character buffer, nothing is allocated, there
+ * are no locales and no exceptions, and errors are reported by a
+ * std::errc. This is much faster than operator<< and formatted input of
+ * streams when many fractions are exchanged as text.
+ *
+ * The bulk versions convert an array of fractions to records separated
+ * by a separator character (a newline by default), and parse such
+ * records back. They stop at the first record that does not fit or
+ * cannot be parsed and report how many fractions were converted, so
+ * that a large file can be written and read in chunks of a fixed
+ * buffer (see fraction-chars.cxx).
+ *
+ */
+
+#ifndef FRACTION_CHARS_HPP
+#define FRACTION_CHARS_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <system_error>
+
+#include "Fraction.hpp"
+
+// Write f as "n/d" into [first,last). On success ptr points behind the
+// last character written; if the buffer is too small, ec is
+// std::errc::value_too_large and ptr is last.
+template<typename TInt>
+std::to_chars_result to_chars(char *first, char *last, const Fraction<TInt> &f)
+{
+    std::to_chars_result r = std::to_chars(first, last, f.n);
+    if (r.ec != std::errc())
+        return r;
+    if (r.ptr == last)
+        return {last, std::errc::value_too_large};
+    *r.ptr++ = '/';
+    return std::to_chars(r.ptr, last, f.d);
+}
+
+// Parse "n/d" or "n" (denominator 1) at the beginning of [first,last)
+// into f, without skipping white space and without normalizing. On
+// error ec is std::errc::invalid_argument (no number or denominator
+// zero) or std::errc::result_out_of_range (too large for TInt), and f
+// is unchanged.
+template<typename TInt>
+std::from_chars_result from_chars(const char *first, const char *last, Fraction<TInt> &f)
+{
+    TInt n = 0, d = 1;
+    std::from_chars_result r = std::from_chars(first, last, n);
+    if (r.ec != std::errc())
+        return r;
+    if (r.ptr != last && *r.ptr == '/')
+    {
+        const char *p = r.ptr;
+        r = std::from_chars(p+1, last, d);
+        if (r.ec != std::errc())
+            return r;
+        if (d == 0)
+            return {first, std::errc::invalid_argument};
+    }
+    f.n = n;
+    f.d = d;
+    return r;
+}
+
+// Results of the bulk conversions: the position behind the last
+// complete record, the number of fractions converted, and the error
+// that stopped the conversion (std::errc() if all were converted)
+struct FractionsToCharsResult
+{
+    char *ptr;
+    std::size_t count;
+    std::errc ec;
+};
+
+struct FractionsFromCharsResult
+{
+    const char *ptr;
+    std::size_t count;
+    std::errc ec;
+};
+
+// Write the m fractions f[0],...,f[m-1] into [first,last), each
+// followed by sep
+template<typename TInt>
+FractionsToCharsResult to_chars(char *first, char *last, const Fraction<TInt> *f,
+                                std::size_t m, char sep='\n')
+{
+    std::size_t i = 0;
+    for (; i<m; i++)
+    {
+        std::to_chars_result r = to_chars(first, last, f[i]);
+        if (r.ec != std::errc() || r.ptr == last)
+            return {first, i, std::errc::value_too_large};
+        *r.ptr++ = sep;
+        first = r.ptr;
+    }
+    return {first, i, std::errc()};
+}
+
+// Parse up to m records of [first,last) into f[0],...,f[m-1]. The
+// records are separated by sep or white space. If the buffer is one
+// chunk of a larger text (more is true), a record at the end of the
+// buffer may be incomplete: it is not parsed, ptr points to its
+// beginning, and the caller moves it to the front of the next chunk.
+template<typename TInt>
+FractionsFromCharsResult from_chars(const char *first, const char *last, Fraction<TInt> *f,
+                                    std::size_t m, char sep='\n', bool more=false)
+{
+    auto separator = [sep](char c){ return c == sep || c == ' ' || c == '\n' || c == '\t' || c == '\r'; };
+
+    std::size_t i = 0;
+    while (first != last && separator(*first))
+        first++;
+    for (; i<m && first != last; i++)
+    {
+        std::from_chars_result r = from_chars(first, last, f[i]);
+        if (r.ec != std::errc() || (r.ptr != last && !separator(*r.ptr)))
+        {
+            // A record that reaches the end of the chunk may be
+            // incomplete, e.g. "12/" of "12/7"
+            const char *p = first;
+            while (p != last && !separator(*p))
+                p++;
+            if (more && p == last)
+                break;
+            return {first, i, r.ec != std::errc() ? r.ec : std::errc::invalid_argument};
+        }
+        if (more && r.ptr == last)
+            break;
+        first = r.ptr;
+        while (first != last && separator(*first))
+            first++;
+    }
+    return {first, i, std::errc()};
+}
+
+#endif // FRACTION_CHARS_HPP
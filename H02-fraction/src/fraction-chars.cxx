@@ -0,0 +1,155 @@
+/**
+ * \file fraction-chars.cxx
+ *
+ * This file is part of the seminar: From the basics of modern OOP to
+ * parallel scientific programming in C++11.
+ *
+ * \brief
+ * In this program we compare the throughput of writing and reading
+ * many fractions as text "n/d" with streams (operator<< and formatted
+ * input) and with the buffer-based conversions of FractionChars.hpp.
+ * Finally, the fractions are written to a file and read back in chunks
+ * of a small fixed buffer.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "FractionChars.hpp"
+
+using namespace std;
+
+// Write f to the file name in chunks of the buffer
+bool write_file(const string &name, const vector<Fraction<>> &f, vector<char> &buffer)
+{
+    ofstream file(name, ios::binary);
+    size_t i = 0;
+    while (i < f.size())
+    {
+        FractionsToCharsResult r = to_chars(buffer.data(), buffer.data()+buffer.size(),
+                                            f.data()+i, f.size()-i);
+        if (r.count == 0)
+            return false;
+        file.write(buffer.data(), r.ptr-buffer.data());
+        i += r.count;
+    }
+    return bool(file);
+}
+
+// Read the fractions of the file name in chunks of the buffer; an
+// incomplete record at the end of a chunk is moved to the front of the
+// buffer and completed by the next chunk
+bool read_file(const string &name, vector<Fraction<>> &f, vector<char> &buffer)
+{
+    ifstream file(name, ios::binary);
+    f.clear();
+    vector<Fraction<>> chunk(buffer.size()/2);
+    size_t kept = 0;
+    for (;;)
+    {
+        file.read(buffer.data()+kept, buffer.size()-kept);
+        const size_t size = kept + size_t(file.gcount());
+        const bool more = bool(file);
+        FractionsFromCharsResult r = from_chars<int>(buffer.data(), buffer.data()+size,
+                                                     chunk.data(), chunk.size(), '\n', more);
+        if (r.ec != errc())
+            return false;
+        f.insert(f.end(), chunk.begin(), chunk.begin()+r.count);
+        kept = size_t(buffer.data()+size-r.ptr);
+        if (!more)
+            return kept == 0;
+        if (kept == buffer.size())
+            return false;
+        copy(r.ptr, static_cast<const char*>(buffer.data()+size), buffer.begin());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t m = 1000000;
+
+    switch (argc)
+    {
+    case 1:
+        break;
+    case 2:
+        m = size_t(atol(argv[1]));
+        break;
+    default:
+        cout << "Usage: fraction-chars" << endl;
+        cout << "       fraction-chars count" << endl;
+        exit(-1);
+    }
+
+    // Random fractions with numerators and denominators of up to 9 digits
+    mt19937 gen(42);
+    uniform_int_distribution<int> num(-999999999, 999999999), den(1, 999999999);
+    vector<Fraction<>> f(m), g(m);
+    for (auto &x : f)
+        x = Fraction<>(num(gen), den(gen));
+
+    // Text written by the stream, used as input for both parsers
+    string text;
+    {
+        ostringstream os;
+        for (const auto &x : f)
+            os << x << '\n';
+        text = os.str();
+    }
+    vector<char> buffer(text.size());
+    cout << m << " fractions, " << text.size() << " bytes" << endl;
+
+    print("ostream operator<<", benchmark([&]()
+    {
+        ostringstream os;
+        for (const auto &x : f)
+            os << x << '\n';
+        do_not_optimize(os);
+    }, 5), double(m));
+
+    print("to_chars (bulk)", benchmark([&]()
+    {
+        FractionsToCharsResult r = to_chars(buffer.data(), buffer.data()+buffer.size(),
+                                            f.data(), f.size());
+        do_not_optimize(r);
+    }, 5), double(m));
+
+    print("istream operator>>", benchmark([&]()
+    {
+        istringstream is(text);
+        char slash;
+        for (auto &x : g)
+            is >> x.n >> slash >> x.d;
+        do_not_optimize(g);
+    }, 5), double(m));
+
+    print("from_chars (bulk)", benchmark([&]()
+    {
+        FractionsFromCharsResult r = from_chars(text.data(), text.data()+text.size(),
+                                                g.data(), g.size());
+        do_not_optimize(r);
+    }, 5), double(m));
+
+    // Round trip with the bulk conversions
+    FractionsToCharsResult w = to_chars(buffer.data(), buffer.data()+buffer.size(), f.data(), f.size());
+    FractionsFromCharsResult r = from_chars(static_cast<const char*>(buffer.data()),
+                                            static_cast<const char*>(w.ptr), g.data(), g.size());
+    cout << "Round trip in memory: " << r.count << " fractions, "
+         << (string(buffer.data(), w.ptr) == text && g == f ? "identical" : "DIFFERENT") << endl;
+
+    // Round trip through a file with a buffer of 4 KiB
+    const string name = "fraction-chars.txt";
+    vector<char> small(4096);
+    vector<Fraction<>> h;
+    const bool ok = write_file(name, f, small) && read_file(name, h, small);
+    remove(name.c_str());
+    cout << "Round trip through a file in 4 KiB chunks: " << h.size() << " fractions, "
+         << (ok && h == f ? "identical" : "DIFFERENT") << endl;
+}
@@ -0,0 +1,22 @@
+#include <iostream>
+
+#include "Fraction.hpp"
+
+// All operations are constexpr and can be evaluated by the compiler
+static_assert(Fraction<>(14, -6, true) == Fraction<>(-7, 3), "normalize");
+static_assert(Fraction<>(1, 2) + Fraction<>(1, 3) == Fraction<>(5, 6), "operator+");
+static_assert(Fraction<>(1, 2) - Fraction<>(1, 3) == Fraction<>(1, 6), "operator-");
+static_assert(Fraction<>(2, 3) * Fraction<>(9, 4) == Fraction<>(3, 2), "operator*");
+static_assert(Fraction<>(2, 3) / Fraction<>(4, 9) == Fraction<>(3, 2), "operator/");
+
+int main()
+{
+    using namespace std;
+    Fraction<> a(2, -3);
+    Fraction<> b(1, 3);
+    Fraction<> c = 1+a+b;
+    cout << "fraction: " << c << ", double: " << double(c) << endl;
+
+    constexpr Fraction<> d = Fraction<>(14, -6, true);
+    cout << "normalized: " << d << endl;
+}